@@ -0,0 +1,92 @@
+/*++
+Copyright (c) 2020 Microsoft Corporation
+
+Module Name:
+
+    quantifier_instance_cache.cpp
+
+Abstract:
+
+    Persistent cache of simplified quantifier instances.
+
+--*/
+#include "ast/quantifier_instance_cache.h"
+
+namespace q {
+
+    unsigned instance_cache::key_hash_proc::operator()(key const * k) const {
+        unsigned h = k->m_q->get_id();
+        for (unsigned i = 0; i < k->m_num_bindings; ++i)
+            h = combine_hash(h, k->m_bindings[i]->get_id());
+        return h;
+    }
+
+    bool instance_cache::key_eq_proc::operator()(key const * k1, key const * k2) const {
+        if (k1->m_q != k2->m_q || k1->m_num_bindings != k2->m_num_bindings)
+            return false;
+        for (unsigned i = 0; i < k1->m_num_bindings; ++i)
+            if (k1->m_bindings[i] != k2->m_bindings[i])
+                return false;
+        return true;
+    }
+
+    instance_cache::instance_cache(ast_manager & m):
+        m(m),
+        m_pinned(m) {
+    }
+
+    instance_cache::key * instance_cache::mk_tmp_key(quantifier * q, unsigned num_bindings, expr * const * bindings) {
+        m_tmp_keys.reserve(num_bindings + 1, nullptr);
+        key * k = m_tmp_keys[num_bindings];
+        if (!k) {
+            k = static_cast<key*>(m_region.allocate(sizeof(key) + sizeof(expr*) * num_bindings));
+            m_tmp_keys[num_bindings] = k;
+        }
+        k->m_q            = q;
+        k->m_num_bindings = num_bindings;
+        for (unsigned i = 0; i < num_bindings; ++i)
+            k->m_bindings[i] = bindings[i];
+        return k;
+    }
+
+    expr * instance_cache::find(quantifier * q, unsigned num_bindings, expr * const * bindings) {
+        expr * result = nullptr;
+        if (m_instances.find(mk_tmp_key(q, num_bindings, bindings), result))
+            m_stats.m_num_hits++;
+        else
+            m_stats.m_num_misses++;
+        return result;
+    }
+
+    void instance_cache::insert(quantifier * q, unsigned num_bindings, expr * const * bindings, expr * inst) {
+        if (m_instances.size() >= m_max_size) {
+            reset();
+            m_stats.m_num_flushes++;
+        }
+        key * k = mk_tmp_key(q, num_bindings, bindings);
+        if (m_instances.contains(k))
+            return;
+        // the scratch key becomes owned by the table
+        m_tmp_keys[num_bindings] = nullptr;
+        m_instances.insert(k, inst);
+        m_pinned.push_back(q);
+        m_pinned.append(num_bindings, bindings);
+        m_pinned.push_back(inst);
+        m_stats.m_num_inserts++;
+    }
+
+    void instance_cache::reset() {
+        m_instances.reset();
+        m_region.reset();
+        m_tmp_keys.reset();
+        m_pinned.reset();
+    }
+
+    void instance_cache::collect_statistics(statistics & st) const {
+        st.update("qi cache hits", m_stats.m_num_hits);
+        st.update("qi cache misses", m_stats.m_num_misses);
+        st.update("qi cache inserts", m_stats.m_num_inserts);
+        st.update("qi cache flushes", m_stats.m_num_flushes);
+    }
+
+};
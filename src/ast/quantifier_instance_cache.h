@@ -0,0 +1,82 @@
+/*++
+Copyright (c) 2020 Microsoft Corporation
+
+Module Name:
+
+    quantifier_instance_cache.h
+
+Abstract:
+
+    Persistent cache of simplified quantifier instances.
+
+    The cache is keyed by a quantifier and the ground terms bound to
+    its variables. Unlike fingerprints, which are tied to enodes and
+    are discarded on pop, entries are pinned expressions and survive
+    backtracking and incremental check-sat calls. A match that is
+    re-discovered in a new scope re-uses the cached instance instead
+    of re-running substitution and simplification.
+
+--*/
+#pragma once
+
+#include "ast/ast.h"
+#include "util/map.h"
+#include "util/region.h"
+#include "util/statistics.h"
+
+namespace q {
+
+    class instance_cache {
+        struct key {
+            quantifier * m_q;
+            unsigned     m_num_bindings;
+            expr *       m_bindings[0];
+        };
+        struct key_hash_proc {
+            unsigned operator()(key const * k) const;
+        };
+        struct key_eq_proc {
+            bool operator()(key const * k1, key const * k2) const;
+        };
+        typedef map<key *, expr *, key_hash_proc, key_eq_proc> instances;
+
+        struct stats {
+            unsigned m_num_hits, m_num_misses, m_num_inserts, m_num_flushes;
+            void reset() { memset(this, 0, sizeof(*this)); }
+            stats() { reset(); }
+        };
+
+        ast_manager&     m;
+        expr_ref_vector  m_pinned;
+        instances        m_instances;
+        region           m_region;
+        ptr_vector<key>  m_tmp_keys; // num_bindings -> scratch key used for lookups
+        unsigned         m_max_size { UINT_MAX };
+        stats            m_stats;
+
+        key * mk_tmp_key(quantifier * q, unsigned num_bindings, expr * const * bindings);
+
+    public:
+        instance_cache(ast_manager & m);
+
+        void set_max_size(unsigned sz) { m_max_size = sz; }
+
+        /**
+           \brief Return the instance cached for q[bindings], or nullptr if there is none.
+        */
+        expr * find(quantifier * q, unsigned num_bindings, expr * const * bindings);
+
+        /**
+           \brief Record that q[bindings] simplifies to inst.
+           The cache is flushed when it exceeds its maximal size.
+        */
+        void insert(quantifier * q, unsigned num_bindings, expr * const * bindings, expr * inst);
+
+        unsigned size() const { return m_instances.size(); }
+
+        void reset();
+
+        void collect_statistics(statistics & st) const;
+    };
+
+};
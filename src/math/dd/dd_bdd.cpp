@@ -45,6 +45,7 @@ namespace dd {
 
         m_spare_entry = nullptr;
         m_max_num_bdd_nodes = 1 << 24; // up to 16M nodes
+        m_max_op_cache_size = 1 << 20;
         m_mark_level = 0;
         alloc_free_nodes(1024 + num_vars);
         m_disable_gc = false;
@@ -202,6 +203,8 @@ namespace dd {
             result->m_op = op;
         }
         else {
+            if (m_op_cache.size() >= m_max_op_cache_size)
+                gc_op_cache();
             void * mem = m_alloc.allocate(sizeof(op_entry));
             result = new (mem) op_entry(l, r, op);
         }
@@ -745,6 +748,30 @@ namespace dd {
         m_free_nodes.reverse();
     }
 
+    /**
+       Remove the entries that have a result from the op cache.
+       Entries without a result belong to operations that are in progress.
+       This also bounds the size of the cache between garbage collections.
+    */
+    void bdd_manager::gc_op_cache() {
+        ptr_vector<op_entry> to_delete, to_keep;
+        for (auto* e : m_op_cache) {            
+            if (e->m_result != null_bdd) {
+                to_delete.push_back(e);
+            }
+            else {
+                to_keep.push_back(e);
+            }
+        }
+        m_op_cache.reset();
+        for (op_entry* e : to_delete) {
+            m_alloc.deallocate(sizeof(*e), e);
+        }
+        for (op_entry* e : to_keep) {
+            m_op_cache.insert(e);
+        }
+    }
+
     void bdd_manager::gc() {
         m_free_nodes.reset();
         IF_VERBOSE(13, verbose_stream() << "(bdd :gc " << m_nodes.size() << ")\n";);
@@ -784,22 +811,7 @@ namespace dd {
         std::sort(m_free_nodes.begin(), m_free_nodes.end());
         m_free_nodes.reverse();
 
-        ptr_vector<op_entry> to_delete, to_keep;
-        for (auto* e : m_op_cache) {            
-            if (e->m_result != null_bdd) {
-                to_delete.push_back(e);
-            }
-            else {
-                to_keep.push_back(e);
-            }
-        }
-        m_op_cache.reset();
-        for (op_entry* e : to_delete) {
-            m_alloc.deallocate(sizeof(*e), e);
-        }
-        for (op_entry* e : to_keep) {
-            m_op_cache.insert(e);
-        }
+        gc_op_cache();
 
         m_node_table.reset();
         // re-populate node cache
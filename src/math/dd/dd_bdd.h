@@ -101,7 +101,7 @@ namespace dd {
 
         struct eq_entry {
             bool operator()(op_entry * a, op_entry * b) const { 
-                return a->m_bdd1 == b->m_bdd2 && a->m_bdd2 == b->m_bdd2 && a->m_op == b->m_op;
+                return a->m_bdd1 == b->m_bdd1 && a->m_bdd2 == b->m_bdd2 && a->m_op == b->m_op;
             }
         };
 
@@ -124,6 +124,7 @@ namespace dd {
         bool                       m_disable_gc;
         bool                       m_is_new_node;
         unsigned                   m_max_num_bdd_nodes;
+        unsigned                   m_max_op_cache_size;
         unsigned_vector            m_S, m_T, m_to_free;  // used for reordering
         vector<unsigned_vector>    m_level2nodes;
         unsigned_vector            m_reorder_rc;
@@ -153,6 +154,7 @@ namespace dd {
         double count(BDD b, unsigned z);
 
         void alloc_free_nodes(unsigned n);
+        void gc_op_cache();
         void init_mark();
         void set_mark(unsigned i) { m_mark[i] = m_mark_level; }
         bool is_marked(unsigned i) { return m_mark[i] == m_mark_level; }
@@ -206,6 +208,7 @@ namespace dd {
         ~bdd_manager();
 
         void set_max_num_nodes(unsigned n) { m_max_num_bdd_nodes = n; }
+        void set_max_op_cache_size(unsigned n) { m_max_op_cache_size = n; }
 
         bdd mk_var(unsigned i);
         bdd mk_nvar(unsigned i);
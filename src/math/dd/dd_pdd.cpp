@@ -26,6 +26,7 @@ namespace dd {
     pdd_manager::pdd_manager(unsigned num_vars, semantics s, unsigned power_of_2) {
         m_spare_entry = nullptr;
         m_max_num_nodes = 1 << 24; // up to 16M nodes
+        m_max_op_cache_size = 1 << 20;
         m_mark_level = 0;
         m_dmark_level = 0;
         m_disable_gc = false;
@@ -810,6 +811,8 @@ namespace dd {
             result->m_op = op;
         }
         else {
+            if (m_op_cache.size() >= m_max_op_cache_size)
+                gc_op_cache();
             void * mem = m_alloc.allocate(sizeof(op_entry));
             result = new (mem) op_entry(l, r, op);
         }
@@ -890,7 +893,8 @@ namespace dd {
             e = m_node_table.insert_if_not_there2(n);
             e->get_data().m_refcount = 0;      
         }
-        if (do_gc) {
+        // grow only if garbage collection did not free a third of the nodes
+        if (do_gc && m_free_nodes.size()*3 < m_nodes.size()) {
             if (m_nodes.size() > m_max_num_nodes) {
                 throw mem_out();
             }
@@ -933,6 +937,52 @@ namespace dd {
         return pdd(m_var2pdd[i], this);        
     }
     
+    pdd pdd_manager::translate(pdd const& p) {
+        pdd_manager& src = p.m;
+        if (&src == this)
+            return p;
+        scoped_push _sp(*this);
+        u_map<PDD> cache;
+        svector<PDD> todo;
+        todo.push_back(p.root);
+        while (!todo.empty()) {
+            PDD r = todo.back();
+            if (cache.contains(r)) {
+                todo.pop_back();
+                continue;
+            }
+            if (src.is_val(r)) {
+                PDD v = imk_val(src.val(r));
+                push(v);
+                cache.insert(r, v);
+                todo.pop_back();
+                continue;
+            }
+            PDD l = null_pdd, h = null_pdd;
+            if (!cache.find(src.lo(r), l))
+                todo.push_back(src.lo(r));
+            if (!cache.find(src.hi(r), h))
+                todo.push_back(src.hi(r));
+            if (l == null_pdd || h == null_pdd)
+                continue;
+            unsigned v = src.var(r);
+            reserve_var(v);
+            PDD n;
+            if (m_var2level[v] == src.level(r))
+                // same variable order, so r can be copied node by node.
+                n = make_node(m_var2level[v], l, h);
+            else {
+                push(apply(m_var2pdd[v], h, pdd_mul_op));
+                n = apply(read(1), l, pdd_add_op);
+                pop(1);
+            }
+            push(n);
+            cache.insert(r, n);
+            todo.pop_back();
+        }
+        return pdd(cache[p.root], this);
+    }
+
     unsigned pdd_manager::dag_size(pdd const& b) {
         init_mark();
         set_mark(0);
@@ -1127,6 +1177,31 @@ namespace dd {
         }
     }
 
+    /**
+       Remove the entries that have a result from the op cache.
+       Entries without a result belong to operations that are in progress
+       and are kept. This is also used to keep the cache bounded, so
+       cached results can be lost between garbage collections.
+    */
+    void pdd_manager::gc_op_cache() {
+        ptr_vector<op_entry> to_delete, to_keep;
+        for (auto* e : m_op_cache) {            
+            if (e->m_result != null_pdd) {
+                to_delete.push_back(e);
+            }
+            else {
+                to_keep.push_back(e);
+            }
+        }
+        m_op_cache.reset();
+        for (op_entry* e : to_delete) {
+            m_alloc.deallocate(sizeof(*e), e);
+        }
+        for (op_entry* e : to_keep) {
+            m_op_cache.insert(e);
+        }
+    }
+
     void pdd_manager::gc() {
         init_dmark();
         m_free_nodes.reset();
@@ -1150,22 +1225,7 @@ namespace dd {
         std::sort(m_free_nodes.begin(), m_free_nodes.end());
         m_free_nodes.reverse();
 
-        ptr_vector<op_entry> to_delete, to_keep;
-        for (auto* e : m_op_cache) {            
-            if (e->m_result != null_pdd) {
-                to_delete.push_back(e);
-            }
-            else {
-                to_keep.push_back(e);
-            }
-        }
-        m_op_cache.reset();
-        for (op_entry* e : to_delete) {
-            m_alloc.deallocate(sizeof(*e), e);
-        }
-        for (op_entry* e : to_keep) {
-            m_op_cache.insert(e);
-        }
+        gc_op_cache();
 
         m_node_table.reset();
         // re-populate node cache
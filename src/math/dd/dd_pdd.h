@@ -134,7 +134,7 @@ namespace dd {
 
         struct eq_entry {
             bool operator()(op_entry * a, op_entry * b) const { 
-                return a->m_pdd1 == b->m_pdd2 && a->m_pdd2 == b->m_pdd2 && a->m_op == b->m_op;
+                return a->m_pdd1 == b->m_pdd1 && a->m_pdd2 == b->m_pdd2 && a->m_op == b->m_op;
             }
         };
 
@@ -159,6 +159,7 @@ namespace dd {
         bool                       m_disable_gc;
         bool                       m_is_new_node;
         unsigned                   m_max_num_nodes;
+        unsigned                   m_max_op_cache_size;
         semantics                  m_semantics;
         unsigned_vector            m_free_vars;
         unsigned_vector            m_free_values;
@@ -167,6 +168,7 @@ namespace dd {
         unsigned                   m_power_of_2 { 0 };
 
         void reset_op_cache();
+        void gc_op_cache();
         void init_nodes(unsigned_vector const& l2v);
         void init_vars(unsigned_vector const& l2v);
 
@@ -265,6 +267,7 @@ namespace dd {
 
         void reset(unsigned_vector const& level2var);
         void set_max_num_nodes(unsigned n) { m_max_num_nodes = n; }
+        void set_max_op_cache_size(unsigned n) { m_max_op_cache_size = n; }
         unsigned_vector const& get_level2var() const { return m_level2var; }
 
         pdd mk_var(unsigned i);
@@ -286,6 +289,11 @@ namespace dd {
         pdd subst_val(pdd const& a, vector<std::pair<unsigned, rational>> const& s);
         pdd subst_val(pdd const& a, unsigned v, rational const& val);
 
+        // copy p, which may belong to a different manager, into this manager.
+        // The manager of p is only read, so several managers can copy from
+        // the same source concurrently.
+        pdd translate(pdd const& p);
+
         bool is_linear(PDD p) { return degree(p) == 1; }
         bool is_linear(pdd const& p);
 
@@ -14,7 +14,11 @@
 #include "math/grobner/pdd_solver.h"
 #include "math/grobner/pdd_simplifier.h"
 #include "util/uint_set.h"
+#include "util/scoped_ptr_vector.h"
 #include <math.h>
+#ifndef SINGLE_THREAD
+#include <thread>
+#endif
 
 
 namespace dd {
@@ -137,11 +141,141 @@ namespace dd {
 
 
     void solver::superpose(equation const & eq) {
+        if (superpose_parallel(eq))
+            return;
         for (equation* target : m_processed) {
             superpose(eq, *target);
         }
     }
 
+    /**
+       Worker of superpose_parallel.
+       It owns a pdd manager with the variable order of the solver's manager
+       and copies the processed equations into it. It computes the S-polynomials
+       of eq with every step-th processed equation, beginning at start, and
+       reduces them by eq and the processed equations. S-polynomials that
+       reduce to zero are dropped.
+    */
+    struct solver::superpose_worker {
+        struct result {
+            pdd             m_poly;
+            unsigned_vector m_deps; // indices into m_processed, UINT_MAX stands for eq
+            result(pdd const& p, unsigned_vector const& deps): m_poly(p), m_deps(deps) {}
+        };
+        solver&        s;
+        reslimit       m_limit;
+        pdd_manager    m;
+        vector<result> m_results;
+        unsigned       m_simplified = 0;
+        unsigned       m_reduced_to_zero = 0;
+        bool           m_too_complex = false;
+        bool           m_failed = false;
+
+        superpose_worker(solver& s):
+            s(s),
+            m(s.m.num_vars(), s.m.get_semantics(), s.m.power_of_2()) {
+            m.reset(s.m.get_level2var());
+        }
+
+        bool reduce(pdd& r, pdd const& q, unsigned idx, unsigned_vector& deps) {
+            m_simplified++;
+            pdd r1 = r.reduce(q);
+            if (r1 == r)
+                return false;
+            if (s.is_too_complex(r1)) {
+                m_too_complex = true;
+                return false;
+            }
+            r = r1;
+            deps.push_back(idx);
+            return true;
+        }
+
+        void operator()(equation const& eq, unsigned start, unsigned step) {
+            try {
+                vector<pdd> S;
+                for (equation* e : s.m_processed)
+                    S.push_back(m.translate(e->poly()));
+                pdd p = m.translate(eq.poly());
+                unsigned_vector deps;
+                for (unsigned i = start; i < S.size() && !m_limit.is_canceled(); i += step) {
+                    pdd r(m);
+                    if (!m.try_spoly(p, S[i], r) || r.is_zero())
+                        continue;
+                    if (s.is_too_complex(r)) {
+                        m_too_complex = true;
+                        continue;
+                    }
+                    deps.reset();
+                    deps.push_back(i);
+                    bool simplified = true;
+                    while (simplified && !r.is_val()) {
+                        simplified = reduce(r, p, UINT_MAX, deps);
+                        for (unsigned j = 0; j < S.size() && !r.is_val(); ++j)
+                            simplified |= reduce(r, S[j], j, deps);
+                    }
+                    if (r.is_zero()) {
+                        m_reduced_to_zero++;
+                        continue;
+                    }
+                    m_results.push_back(result(r, deps));
+                }
+            }
+            catch (pdd_manager::mem_out) {
+                m_failed = true;
+            }
+        }
+    };
+
+    /**
+       Superpose eq with the processed equations using m_config.m_threads threads.
+       The solver's manager is not touched while the workers run. They only read
+       it to copy the equations. Their results are copied back in a fixed order.
+       Return false if the sequential version should be used instead.
+    */
+    bool solver::superpose_parallel(equation const& eq) {
+#ifdef SINGLE_THREAD
+        return false;
+#else
+        unsigned num_threads = m_config.m_threads;
+        if (num_threads <= 1 || m_processed.size() < 4 * num_threads)
+            return false;
+        scoped_ptr_vector<superpose_worker> workers;
+        scoped_limits sl(m_limit);
+        for (unsigned i = 0; i < num_threads; ++i) {
+            workers.push_back(alloc(superpose_worker, *this));
+            sl.push_child(&workers[i]->m_limit);
+        }
+        vector<std::thread> threads(num_threads);
+        for (unsigned i = 0; i < num_threads; ++i)
+            threads[i] = std::thread([&, i]() { (*workers[i])(eq, i, num_threads); });
+        for (auto& th : threads)
+            th.join();
+        for (unsigned i = 0; i < num_threads; ++i) {
+            superpose_worker& w = *workers[i];
+            m_stats.incr_simplified(w.m_simplified);
+            if (w.m_too_complex)
+                m_too_complex = true;
+            if (w.m_failed) {
+                for (unsigned j = i; j < m_processed.size(); j += num_threads)
+                    superpose(eq, *m_processed[j]);
+                continue;
+            }
+            m_stats.m_reduced_to_zero += w.m_reduced_to_zero;
+            for (auto const& r : w.m_results) {
+                u_dependency* d = eq.dep();
+                for (unsigned j : r.m_deps)
+                    if (j != UINT_MAX)
+                        d = m_dep_manager.mk_join(d, m_processed[j]->dep());
+                m_stats.m_superposed++;
+                m_stats.m_parallel_superposed++;
+                add(m.translate(r.m_poly), d);
+            }
+        }
+        return true;
+#endif
+    }
+
     /*
       Use a set of equations to simplify eq
     */
@@ -429,6 +563,8 @@ namespace dd {
         st.update("dd.solver.steps", m_stats.m_compute_steps);
         st.update("dd.solver.simplified", m_stats.simplified());
         st.update("dd.solver.superposed", m_stats.m_superposed);
+        st.update("dd.solver.parallel_superposed", m_stats.m_parallel_superposed);
+        st.update("dd.solver.reduced_to_zero", m_stats.m_reduced_to_zero);
         st.update("dd.solver.processed", m_processed.size());
         st.update("dd.solver.solved", m_solved.size());
         st.update("dd.solver.to_simplify", m_to_simplify.size());
@@ -39,12 +39,17 @@ public:
         unsigned m_max_expr_degree;
         unsigned m_superposed;
         unsigned m_compute_steps;
+        unsigned m_parallel_superposed;
+        unsigned m_reduced_to_zero;
         void reset() { memset(this, 0, sizeof(*this)); }
         stats() { reset(); }
         unsigned simplified() const { return m_simplified; }
         void incr_simplified() {
             m_simplified++;
         }
+        void incr_simplified(unsigned n) {
+            m_simplified += n;
+        }
         
     };
 
@@ -60,6 +65,7 @@ public:
         unsigned m_expr_size_growth;
         unsigned m_expr_degree_growth;
         unsigned m_number_of_conflicts_to_report;
+        unsigned m_threads;
         config() :
             m_eqs_threshold(UINT_MAX),
             m_expr_size_limit(UINT_MAX),
@@ -71,7 +77,8 @@ public:
             m_eqs_growth(10),
             m_expr_size_growth(10),
             m_expr_degree_growth(5),
-            m_number_of_conflicts_to_report(1)
+            m_number_of_conflicts_to_report(1),
+            m_threads(1)
         {}
     };
 
@@ -157,6 +164,8 @@ private:
     bool done();
     void superpose(equation const& eq1, equation const& eq2);
     void superpose(equation const& eq);
+    struct superpose_worker;
+    bool superpose_parallel(equation const& eq);
     void simplify_using(equation& eq, equation_vector const& eqs);
     void simplify_using(equation_vector& set, equation const& eq);
     void simplify_using(equation & dst, equation const& src, bool& changed_leading_term);
@@ -22,6 +22,7 @@ Revision History:
 #pragma once
 
 #include "util/vector.h"
+#include "util/checked_int64.h"
 #include "math/lp/implied_bound.h"
 #include "math/lp/test_bound_analyzer.h"
 
@@ -163,8 +164,90 @@ private:
         return a * (is_neg(a) ? ub(j).x : lb(j).x);
     }
     
+    typedef checked_int64<true> int64c;
+
+    // Fast path for rows whose coefficients and the bounds participating in the
+    // analysis are integers that fit in 64 bits. The partial sums are computed with
+    // checked int64 arithmetic and the exact mpq arithmetic below is used
+    // when a value does not fit or an operation overflows.
+    // It uses m_total/a + v = (m_total + a*v)/a, so only one mpq division per bound is needed.
+    bool limit_all_monoids_int64(bool from_below) {
+        try {
+            int64c total;
+            int strict = 0;
+            for (const auto& p : m_row) {
+                bool str;
+                const mpq& a = p.coeff();
+                const mpq& v = from_below ?
+                    monoid_max_no_mult(is_pos(a), p.var(), str) :
+                    monoid_min_no_mult(is_pos(a), p.var(), str);
+                if (!a.is_int64() || !v.is_int64())
+                    return false;
+                total -= int64c(a.get_int64()) * int64c(v.get_int64());
+                if (str)
+                    strict++;
+            }
+            for (const auto& p : m_row) {
+                bool str;
+                const mpq& a = p.coeff();
+                bool a_is_pos = is_pos(a);
+                const mpq& v = from_below ?
+                    monoid_max_no_mult(a_is_pos, p.var(), str) :
+                    monoid_min_no_mult(a_is_pos, p.var(), str);
+                int64c num = total + int64c(a.get_int64()) * int64c(v.get_int64());
+                m_bound = mpq(num.get_int64(), mpq::i64());
+                if (!a.is_one())
+                    m_bound /= a;
+                // bounds passed to m_bp before an overflow are passed again by the exact
+                // version, which is harmless since m_bp only keeps the best bound.
+                limit_j(p.var(), m_bound, a_is_pos, a_is_pos == from_below, strict - static_cast<int>(str) > 0);
+            }
+            return true;
+        }
+        catch (int64c::overflow_exception &) {
+            return false;
+        }
+    }
+
+    // int64 version of limit_monoid_u_from_below (from_below) and limit_monoid_l_from_above.
+    bool limit_monoid_int64(unsigned j, bool from_below) {
+        if (!m_rs.x.is_int64())
+            return false;
+        try {
+            int64c total = -int64c(m_rs.x.get_int64());
+            const mpq* j_coeff = nullptr;
+            bool strict = false;
+            for (const auto& p : m_row) {
+                const mpq& a = p.coeff();
+                if (p.var() == j) {
+                    j_coeff = &a;
+                    continue;
+                }
+                bool str;
+                const mpq& v = from_below ?
+                    monoid_max_no_mult(is_pos(a), p.var(), str) :
+                    monoid_min_no_mult(is_pos(a), p.var(), str);
+                if (!a.is_int64() || !v.is_int64())
+                    return false;
+                total -= int64c(a.get_int64()) * int64c(v.get_int64());
+                if (str)
+                    strict = true;
+            }
+            m_bound = mpq(total.get_int64(), mpq::i64());
+            m_bound /= *j_coeff;
+            bool c_is_pos = is_pos(*j_coeff);
+            limit_j(j, m_bound, c_is_pos, c_is_pos == from_below, strict);
+            return true;
+        }
+        catch (int64c::overflow_exception &) {
+            return false;
+        }
+    }
+
     mpq m_total, m_bound;
     void limit_all_monoids_from_above() {
+        if (limit_all_monoids_int64(false))
+            return;
         int strict = 0;
         m_total.reset();
         lp_assert(is_zero(m_total));
@@ -191,6 +274,8 @@ private:
     }
 
     void limit_all_monoids_from_below() {
+        if (limit_all_monoids_int64(true))
+            return;
         int strict = 0;
         m_total.reset();
         lp_assert(is_zero(m_total));
@@ -221,6 +306,8 @@ private:
     void limit_monoid_u_from_below() {
         // we are going to limit from below the monoid m_column_of_u,
         // every other monoid is impossible to limit from below
+        if (limit_monoid_int64(m_column_of_u, true))
+            return;
         mpq u_coeff;
         unsigned j;
         m_bound = -m_rs.x;
@@ -250,6 +337,8 @@ private:
     void limit_monoid_l_from_above() {
         // we are going to limit from above the monoid m_column_of_l,
         // every other monoid is impossible to limit from above
+        if (limit_monoid_int64(m_column_of_l, false))
+            return;
         mpq l_coeff;
         unsigned j;
         m_bound = -m_rs.x;
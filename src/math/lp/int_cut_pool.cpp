@@ -0,0 +1,196 @@
+/*++
+Copyright (c) 2020 Microsoft Corporation
+
+Module Name:
+
+    int_cut_pool.cpp
+
+Abstract:
+
+    Pool of Gomory and HNF cuts that survives backtracking.
+
+Revision History:
+--*/
+
+#include <algorithm>
+#include "math/lp/int_solver.h"
+#include "math/lp/lar_solver.h"
+#include "math/lp/int_cut_pool.h"
+
+namespace lp {
+
+    int_cut_pool::int_cut_pool(int_solver& lia): lia(lia), lra(lia.lra) {}
+
+    bool int_cut_pool::should_apply() const {
+        return lia.settings().cut_pool_size() > 0 && !m_cuts.empty();
+    }
+
+    /**
+       Find a pooled cut whose bounds still hold and that is violated by
+       the current solution, and hand it back to int_solver as a fresh cut.
+     */
+    lia_move int_cut_pool::operator()() {
+        if (!find(lia.m_t, lia.m_k, lia.m_upper, *lia.m_ex))
+            return lia_move::undef;
+        SASSERT(lia.current_solution_is_inf_on_cut());
+        return lia_move::cut;
+    }
+
+    bool int_cut_pool::find(lar_term& t, mpq& k, bool& upper, explanation& ex) {
+        auto& st = lia.settings().stats();
+        st.m_cut_pool_lookups++;
+        unsigned found = UINT_MAX;
+        for (unsigned i = 0; i < m_cuts.size(); ++i) {
+            cut& c = m_cuts[i];
+            if (found == UINT_MAX && is_violated(c) && is_valid(c)) {
+                found = i;
+                c.m_age = 0;
+            }
+            else
+                c.m_age++;
+        }
+        for (unsigned i = m_cuts.size(); i-- > 0; ) {
+            if (m_cuts[i].m_age > m_max_age) {
+                if (found != UINT_MAX && found == m_cuts.size() - 1)
+                    found = i;
+                evict(i);
+            }
+        }
+        if (found == UINT_MAX)
+            return false;
+        st.m_cut_pool_hits++;
+        apply(m_cuts[found], t, k, upper, ex);
+        TRACE("int_cut_pool", tout << "reusing cut " << found << " of " << m_cuts.size() << "\n";);
+        return true;
+    }
+
+    lia_move int_cut_pool::record(lia_move r) {
+        if (r == lia_move::cut)
+            record(lia.m_t, lia.m_k, lia.m_upper, *lia.m_ex);
+        return r;
+    }
+
+    void int_cut_pool::record(lar_term const& t, mpq const& k, bool upper, explanation const& ex) {
+        if (lia.settings().cut_pool_size() == 0)
+            return;
+        cut c;
+        if (!snapshot(c, t, k, upper, ex))
+            return;
+        for (unsigned i = 0; i < m_cuts.size(); ++i) {
+            cut const& d = m_cuts[i];
+            if (d.m_upper == c.m_upper && d.m_k == c.m_k && d.m_coeffs == c.m_coeffs) {
+                evict(i);
+                break;
+            }
+        }
+        if (m_cuts.size() >= lia.settings().cut_pool_size())
+            evict_oldest();
+        m_cuts.push_back(c);
+        lia.settings().stats().m_cut_pool_inserts++;
+    }
+
+    /**
+       Remove cuts that refer to columns at or above n.
+       Column indices get reused after a pop, so such cuts may no longer
+       mean what they meant when they were recorded.
+     */
+    void int_cut_pool::pop_columns(unsigned n) {
+        unsigned j = 0;
+        for (unsigned i = 0; i < m_cuts.size(); ++i) {
+            if (m_cuts[i].m_max_column >= n)
+                continue;
+            if (i != j)
+                m_cuts[j] = m_cuts[i];
+            ++j;
+        }
+        m_cuts.shrink(j);
+    }
+
+    bool int_cut_pool::snapshot(cut& c, lar_term const& t, mpq const& k, bool upper, explanation const& ex) {
+        for (auto p : t) {
+            c.m_coeffs.push_back(std::make_pair(p.coeff(), p.column().index()));
+            c.m_max_column = std::max(c.m_max_column, p.column().index());
+        }
+        std::sort(c.m_coeffs.begin(), c.m_coeffs.end(),
+                  [](std::pair<mpq, unsigned> const& a, std::pair<mpq, unsigned> const& b) { return a.second < b.second; });
+        c.m_k = k;
+        c.m_upper = upper;
+        for (auto ev : ex) {
+            auto const& con = lra.constraints()[ev.ci()];
+            unsigned j = con.column();
+            bool lower = false, upper = false;
+            switch (con.kind()) {
+            case LE: case LT: upper = true; break;
+            case GE: case GT: lower = true; break;
+            case EQ: lower = upper = true; break;
+            default: return false;
+            }
+            if (lower) {
+                if (!lia.has_lower(j))
+                    return false;
+                c.m_bounds.push_back(bound_ref(j, true, lia.lower_bound(j)));
+            }
+            if (upper) {
+                if (!lia.has_upper(j))
+                    return false;
+                c.m_bounds.push_back(bound_ref(j, false, lia.upper_bound(j)));
+            }
+            c.m_max_column = std::max(c.m_max_column, j);
+        }
+        return true;
+    }
+
+    bool int_cut_pool::is_valid(cut const& c) const {
+        if (c.m_max_column >= lra.column_count())
+            return false;
+        for (auto const& b : c.m_bounds) {
+            if (b.m_is_lower) {
+                if (!lia.has_lower(b.m_j) || lia.lower_bound(b.m_j) < b.m_bound)
+                    return false;
+            }
+            else if (!lia.has_upper(b.m_j) || lia.upper_bound(b.m_j) > b.m_bound)
+                return false;
+        }
+        return true;
+    }
+
+    bool int_cut_pool::is_violated(cut const& c) const {
+        if (c.m_max_column >= lra.column_count())
+            return false;
+        impq v(0);
+        for (auto const& p : c.m_coeffs)
+            v += p.first * lia.get_value(p.second);
+        return c.m_upper ? v > impq(c.m_k) : v < impq(c.m_k);
+    }
+
+    void int_cut_pool::apply(cut const& c, lar_term& t, mpq& k, bool& upper, explanation& ex) {
+        t.clear();
+        for (auto const& p : c.m_coeffs)
+            t.add_monomial(p.first, p.second);
+        k = c.m_k;
+        upper = c.m_upper;
+        ex.clear();
+        for (auto const& b : c.m_bounds) {
+            if (b.m_is_lower)
+                ex.push_back(lia.column_lower_bound_constraint(b.m_j));
+            else
+                ex.push_back(lia.column_upper_bound_constraint(b.m_j));
+        }
+    }
+
+    void int_cut_pool::evict(unsigned i) {
+        m_cuts[i] = m_cuts.back();
+        m_cuts.pop_back();
+        lia.settings().stats().m_cut_pool_evictions++;
+    }
+
+    void int_cut_pool::evict_oldest() {
+        if (m_cuts.empty())
+            return;
+        unsigned oldest = 0;
+        for (unsigned i = 1; i < m_cuts.size(); ++i)
+            if (m_cuts[i].m_age > m_cuts[oldest].m_age)
+                oldest = i;
+        evict(oldest);
+    }
+}
@@ -0,0 +1,76 @@
+/*++
+Copyright (c) 2020 Microsoft Corporation
+
+Module Name:
+
+    int_cut_pool.h
+
+Abstract:
+
+    Pool of Gomory and HNF cuts that survives backtracking.
+
+    A cut t >= k (or t <= k) is implied by the tableau, the integrality
+    of its columns and the bounds listed in its explanation.
+    The pool records a cut together with the bound values it relied on.
+    When the lemma for the cut is lost by backtracking, the cut can be
+    re-added as long as the current bounds are at least as tight as the
+    recorded ones. The explanation is then rebuilt from the witnesses of
+    the current bounds.
+
+    Cuts that mention columns that get popped are removed. Cuts that have
+    not been re-added for a while are aged out.
+
+Revision History:
+--*/
+#pragma once
+
+#include "math/lp/lia_move.h"
+#include "math/lp/lar_term.h"
+#include "math/lp/explanation.h"
+
+namespace lp {
+    class int_solver;
+    class lar_solver;
+    class int_cut_pool {
+
+        struct bound_ref {
+            unsigned m_j;
+            bool     m_is_lower;
+            impq     m_bound;
+            bound_ref(unsigned j, bool is_lower, impq const& b): m_j(j), m_is_lower(is_lower), m_bound(b) {}
+        };
+
+        struct cut {
+            vector<std::pair<mpq, unsigned>> m_coeffs; // sorted by column
+            mpq                m_k;
+            bool               m_upper;
+            vector<bound_ref>  m_bounds;
+            unsigned           m_max_column = 0;
+            unsigned           m_age = 0;
+        };
+
+        class int_solver& lia;
+        class lar_solver& lra;
+        vector<cut>       m_cuts;
+        unsigned          m_max_age = 256;
+
+        bool snapshot(cut& c, lar_term const& t, mpq const& k, bool upper, explanation const& ex);
+        bool is_valid(cut const& c) const;
+        bool is_violated(cut const& c) const;
+        void apply(cut const& c, lar_term& t, mpq& k, bool& upper, explanation& ex);
+        void evict(unsigned i);
+        void evict_oldest();
+    public:
+        int_cut_pool(int_solver& lia);
+        bool should_apply() const;
+        lia_move operator()();
+        // record the cut currently stored in lia if r is lia_move::cut
+        lia_move record(lia_move r);
+        // record the cut t <= k (upper) or t >= k implied by the bounds in ex
+        void record(lar_term const& t, mpq const& k, bool upper, explanation const& ex);
+        // store in t, k, upper, ex a pooled cut that is valid and violated by the current solution
+        bool find(lar_term& t, mpq& k, bool& upper, explanation& ex);
+        void pop_columns(unsigned n);
+        unsigned size() const { return m_cuts.size(); }
+    };
+}
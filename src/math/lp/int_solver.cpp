@@ -122,7 +122,8 @@ int_solver::int_solver(lar_solver& lar_slv) :
     m_patcher(*this),
     m_number_of_calls(0),
     m_hnf_cutter(*this),
-    m_hnf_cut_period(settings().hnf_cut_period()) {
+    m_hnf_cut_period(settings().hnf_cut_period()),
+    m_cut_pool(*this) {
     lra.set_int_solver(this);
 }
 
@@ -161,8 +162,9 @@ lia_move int_solver::check(lp::explanation * e) {
     ++m_number_of_calls;
     if (r == lia_move::undef && m_patcher.should_apply()) r = m_patcher();
     if (r == lia_move::undef && should_find_cube()) r = int_cube(*this)();
-    if (r == lia_move::undef && should_hnf_cut()) r = hnf_cut();
-    if (r == lia_move::undef && should_gomory_cut()) r = gomory(*this)();
+    if (r == lia_move::undef && m_cut_pool.should_apply() && (should_hnf_cut() || should_gomory_cut())) r = m_cut_pool();
+    if (r == lia_move::undef && should_hnf_cut()) r = m_cut_pool.record(hnf_cut());
+    if (r == lia_move::undef && should_gomory_cut()) r = m_cut_pool.record(gomory(*this)());
     if (r == lia_move::undef) r = int_branch(*this)();
     return r;
 }
@@ -25,6 +25,7 @@ Revision History:
 #include "math/lp/lar_constraints.h"
 #include "math/lp/hnf_cutter.h"
 #include "math/lp/int_gcd_test.h"
+#include "math/lp/int_cut_pool.h"
 #include "math/lp/lia_move.h"
 #include "math/lp/explanation.h"
 
@@ -39,6 +40,7 @@ class int_solver {
     friend class int_branch;
     friend class int_gcd_test;
     friend class hnf_cutter;
+    friend class int_cut_pool;
 
     class patcher {
         int_solver&         lia;
@@ -68,6 +70,7 @@ class int_solver {
     bool                m_upper;           // we have a cut m_t*x <= k if m_upper is true nad m_t*x >= k otherwise
     hnf_cutter          m_hnf_cutter;
     unsigned            m_hnf_cut_period;
+    int_cut_pool        m_cut_pool;
 public:
     int_solver(lar_solver& lp);
     
@@ -129,5 +132,7 @@ public:
     void find_feasible_solution();
     lia_move hnf_cut();
     void patch_nbasic_column(unsigned j) { m_patcher.patch_nbasic_column(j); }
+    void pop_columns(unsigned n) { m_cut_pool.pop_columns(n); }
+    int_cut_pool& cut_pool() { return m_cut_pool; }
   };
 }
@@ -110,6 +110,7 @@ public:
     void prefix_r();
 
     void prefix_d();
+    static void prefix_double_solver(lp_primal_core_solver<double, double> & s);
 
     unsigned m_m() const { return m_r_A.row_count();  }
 
@@ -231,6 +232,10 @@ public:
         return settings().simplex_strategy() == simplex_strategy_enum::lu;
     }
 
+    bool need_to_presolve_with_double_tableau() const {
+        return settings().use_tableau_rows() && settings().presolve_with_double_solver_for_lar;
+    }
+
     template <typename L>
     bool is_zero_vector(const vector<L> & b) {
         for (const L & m: b)
@@ -677,6 +682,11 @@ public:
         }
         
     }
+    bool find_solution_signature_with_double_tableau(lar_solution_signature & signature,
+                                                     vector<unsigned> & changes_of_basis,
+                                                     vector<int> & d_heading);
+    void solve_with_double_tableau();
+
     // returns the trace of basis changes
     vector<unsigned> find_solution_signature_with_doubles(lar_solution_signature & signature) {
         if (m_d_solver.m_factorization == nullptr || m_d_solver.m_factorization->get_status() != LU_status::OK) {
@@ -11,6 +11,7 @@ Revision History:
 --*/
 #include <string>
 #include "util/vector.h"
+#include "util/util.h"
 #include "math/lp/lar_core_solver.h"
 #include "math/lp/lar_solution_signature.h"
 namespace lp {
@@ -76,21 +77,105 @@ void lar_core_solver::prefix_r() {
 }
 
 void lar_core_solver::prefix_d() {
-    m_d_solver.m_b.resize(m_d_solver.m_m());
-    m_d_solver.m_breakpoint_indices_queue.resize(m_d_solver.m_n());
-    m_d_solver.m_copy_of_xB.resize(m_d_solver.m_n());
-    m_d_solver.m_costs.resize(m_d_solver.m_n());
-    m_d_solver.m_d.resize(m_d_solver.m_n());
-    m_d_solver.m_ed.resize(m_d_solver.m_m());
-    m_d_solver.m_pivot_row.resize(m_d_solver.m_n());
-    m_d_solver.m_pivot_row_of_B_1.resize(m_d_solver.m_m());
-    m_d_solver.m_w.resize(m_d_solver.m_m());
-    m_d_solver.m_y.resize(m_d_solver.m_m());
-    m_d_solver.m_steepest_edge_coefficients.resize(m_d_solver.m_n());
-    m_d_solver.m_column_norms.clear();
-    m_d_solver.m_column_norms.resize(m_d_solver.m_n(), 2);
-    m_d_solver.clear_inf_set();
-    m_d_solver.resize_inf_set(m_d_solver.m_n());
+    prefix_double_solver(m_d_solver);
+}
+
+void lar_core_solver::prefix_double_solver(lp_primal_core_solver<double, double> & s) {
+    s.m_b.resize(s.m_m());
+    s.m_breakpoint_indices_queue.resize(s.m_n());
+    s.m_copy_of_xB.resize(s.m_n());
+    s.m_costs.resize(s.m_n());
+    s.m_d.resize(s.m_n());
+    s.m_ed.resize(s.m_m());
+    s.m_pivot_row.resize(s.m_n());
+    s.m_pivot_row_of_B_1.resize(s.m_m());
+    s.m_w.resize(s.m_m());
+    s.m_y.resize(s.m_m());
+    s.m_steepest_edge_coefficients.resize(s.m_n());
+    s.m_column_norms.clear();
+    s.m_column_norms.resize(s.m_n(), 2);
+    s.clear_inf_set();
+    s.resize_inf_set(s.m_n());
+}
+
+/**
+   Run the primal simplex in doubles on a copy of the tableau, starting from the
+   current basis and values of m_r_solver. On success, signature holds the positions
+   of the non-basic columns found by the double solver, changes_of_basis the trace of
+   its pivots, and d_heading its final basis heading.
+   The double solver uses an LU factorization, so the strategy is switched to lu while it runs.
+
+   The double copy of the tableau and its factorization are rebuilt on every call.
+   Between two calls the exact tableau is pivoted and gets new rows and columns, so a
+   cached copy would have to replay all of these changes, which costs as much as the
+   copy. Building the copy is linear in the number of non-zeros of the tableau, plus one
+   factorization of the current basis, and both are in doubles. This is cheap next to the
+   exact pivots the presolve saves when the rational simplex needs many of them, but it is
+   paid on every call, also when the exact solver would need only a few pivots. That is why
+   arith.presolve_with_doubles is off by default.
+*/
+bool lar_core_solver::find_solution_signature_with_double_tableau(lar_solution_signature & signature,
+                                                                  vector<unsigned> & changes_of_basis,
+                                                                  vector<int> & d_heading) {
+    unsigned m = m_r_A.row_count();
+    unsigned n = m_r_A.column_count();
+    static_matrix<double, double> A(m, n);
+    create_double_matrix(A);
+    get_bounds_for_double_solver();
+    double delta = find_delta_for_strict_boxed_bounds().get_double();
+    if (delta > 0.000001)
+        delta = 0.000001;
+    vector<double> b(m, 0.0), costs(n, 0.0), x(n, 0.0);
+    for (unsigned j = 0; j < n; j++)
+        x[j] = m_r_x[j].x.get_double() + delta * m_r_x[j].y.get_double();
+    vector<unsigned> basis(m_r_basis), nbasis(m_r_nbasis);
+    d_heading = m_r_heading;
+
+    flet<simplex_strategy_enum> _strategy(settings().simplex_strategy(), simplex_strategy_enum::lu);
+    bool ok = false;
+    {
+        lp_primal_core_solver<double, double> d(A, b, x, basis, nbasis, d_heading, costs,
+                                                m_column_types(), m_d_lower_bounds, m_d_upper_bounds,
+                                                settings(), m_r_solver.m_column_names);
+        prefix_double_solver(d);
+        init_factorization(d.m_factorization, A, basis, settings());
+        if (d.m_factorization->get_status() == LU_status::OK) {
+            extract_signature_from_lp_core_solver(m_r_solver, signature);
+            prepare_solver_x_with_signature(signature, d);
+            d.solve_Ax_eq_b();
+            d.start_tracing_basis_changes();
+            d.find_feasible_solution();
+            d.stop_tracing_basis_changes();
+            ok = !settings().get_cancel_flag() && d.get_status() != lp_status::FLOATING_POINT_ERROR;
+            if (ok) {
+                extract_signature_from_lp_core_solver(d, signature);
+                changes_of_basis = d.m_trace_of_basis_change_vector;
+            }
+        }
+    }
+    return ok;
+}
+
+/**
+   Floating-point-first search for a feasible solution: the exact tableau is pivoted
+   to the basis found by the double solver, the non-basic columns are moved to the bounds
+   chosen by the double solver, and m_r_solver repairs the remaining infeasibilities
+   in rationals. The result is exact, only the starting point comes from doubles.
+*/
+void lar_core_solver::solve_with_double_tableau() {
+    lar_solution_signature signature;
+    vector<unsigned> changes_of_basis;
+    vector<int> d_heading;
+    if (find_solution_signature_with_double_tableau(signature, changes_of_basis, d_heading)) {
+        ++settings().stats().m_double_presolves;
+        settings().stats().m_double_presolve_pivots += changes_of_basis.size() / 2;
+        // if an exact pivot fails the basis reached so far is kept
+        catch_up_in_lu_tableau(changes_of_basis, d_heading);
+        for (unsigned j = 0; j < m_r_solver.m_n(); j++)
+            m_r_solver.track_column_feasibility(j);
+        prepare_solver_x_with_signature_tableau(signature);
+    }
+    m_r_solver.find_feasible_solution();
 }
 
 void lar_core_solver::fill_not_improvable_zero_sum_from_inf_row() {
@@ -172,7 +257,9 @@ void lar_core_solver::solve() {
             if (snapped)
                 m_r_solver.solve_Ax_eq_b();
         }
-        if (m_r_solver.m_look_for_feasible_solution_only) //todo : should it be set?
+        if (m_r_solver.m_look_for_feasible_solution_only && need_to_presolve_with_double_tableau())
+            solve_with_double_tableau();
+        else if (m_r_solver.m_look_for_feasible_solution_only) //todo : should it be set?
             m_r_solver.find_feasible_solution();
         else {
             m_r_solver.solve();
@@ -279,6 +279,8 @@ namespace lp {
             }
         );
         m_columns_to_ul_pairs.pop(k);
+        if (m_int_solver)
+            m_int_solver->pop_columns(n);
 
         m_mpq_lar_core_solver.pop(k);
         remove_non_fixed_from_fixed_var_table();
@@ -32,5 +32,7 @@ void lp::lp_settings::updt_params(params_ref const& _p) {
     m_print_external_var_name = p.arith_print_ext_var_names();
     report_frequency = p.arith_rep_freq();
     m_simplex_strategy = static_cast<lp::simplex_strategy_enum>(p.arith_simplex_strategy());
+    presolve_with_double_solver_for_lar = p.arith_presolve_with_doubles();
     m_nlsat_delay = p.arith_nl_delay();
+    m_cut_pool_size = p.arith_cut_pool_size();
 }
@@ -123,9 +123,16 @@ struct statistics {
     unsigned m_horner_calls;
     unsigned m_horner_conflicts;
     unsigned m_cross_nested_forms;
+    unsigned m_cross_nested_forms_fp;
     unsigned m_grobner_calls;
     unsigned m_grobner_conflicts;
     unsigned m_cheap_eqs;
+    unsigned m_double_presolves;
+    unsigned m_double_presolve_pivots;
+    unsigned m_cut_pool_lookups;
+    unsigned m_cut_pool_hits;
+    unsigned m_cut_pool_inserts;
+    unsigned m_cut_pool_evictions;
     statistics() { reset(); }
     void reset() { memset(this, 0, sizeof(*this)); }
     void collect_statistics(::statistics& st) const {
@@ -144,9 +151,16 @@ struct statistics {
         st.update("arith-horner-calls", m_horner_calls);
         st.update("arith-horner-conflicts", m_horner_conflicts);
         st.update("arith-horner-cross-nested-forms", m_cross_nested_forms);
+        st.update("arith-horner-cross-nested-forms-fp", m_cross_nested_forms_fp);
         st.update("arith-grobner-calls", m_grobner_calls);
         st.update("arith-grobner-conflicts", m_grobner_conflicts);
         st.update("arith-cheap-eqs", m_cheap_eqs);
+        st.update("arith-double-presolves", m_double_presolves);
+        st.update("arith-double-presolve-pivots", m_double_presolve_pivots);
+        st.update("arith-cut-pool-lookups", m_cut_pool_lookups);
+        st.update("arith-cut-pool-hits", m_cut_pool_hits);
+        st.update("arith-cut-pool-inserts", m_cut_pool_inserts);
+        st.update("arith-cut-pool-evictions", m_cut_pool_evictions);
 
     }
 };
@@ -217,7 +231,7 @@ public:
     double       relative_primal_feasibility_tolerance { 1e-9 }; // page 71 of the PhD thesis of Achim Koberstein
     // end of dual section
     bool                   m_bound_propagation { true };
-    bool                   presolve_with_double_solver_for_lar { true };
+    bool                   presolve_with_double_solver_for_lar { false };
     simplex_strategy_enum  m_simplex_strategy;
     
     int              report_frequency { 1000 };
@@ -233,6 +247,7 @@ public:
     unsigned         m_int_find_cube_period { 4 };
 private:
     unsigned         m_hnf_cut_period { 4 };
+    unsigned         m_cut_pool_size { 0 };
     bool             m_int_run_gcd_test { true };
 public:
     unsigned         limit_on_rows_for_hnf_cutter { 75 };
@@ -247,6 +262,7 @@ public:
     bool cheap_eqs() const { return m_cheap_eqs;}
     unsigned hnf_cut_period() const { return m_hnf_cut_period; }
     void set_hnf_cut_period(unsigned period) { m_hnf_cut_period = period;  }
+    unsigned cut_pool_size() const { return m_cut_pool_size; }
     unsigned random_next() { return m_rand(); }
     void set_random_seed(unsigned s) { m_rand.set_seed(s); }
 
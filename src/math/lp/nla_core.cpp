@@ -1695,6 +1695,7 @@ void core::configure_grobner() {
     cfg.m_expr_size_growth = m_nla_settings.grobner_expr_size_growth();
     cfg.m_expr_degree_growth = m_nla_settings.grobner_expr_degree_growth();
     cfg.m_number_of_conflicts_to_report = m_nla_settings.grobner_number_of_conflicts_to_report();
+    cfg.m_threads = m_nla_settings.grobner_threads();
     m_pdd_grobner.set(cfg);
     m_pdd_grobner.adjust_cfg();
     m_pdd_manager.set_max_num_nodes(10000); // or something proportional to the number of initial nodes.
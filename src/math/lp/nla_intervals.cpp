@@ -1,3 +1,5 @@
+#include <cmath>
+#include <limits>
 #include "math/lp/nla_core.h"
 #include "math/interval/interval_def.h"
 #include "math/lp/nla_intervals.h"
@@ -6,6 +8,67 @@
 namespace nla {
 typedef enum dep_intervals::with_deps_t e_with_deps;
 
+namespace {
+    const double fp_inf = std::numeric_limits<double>::infinity();
+    const double fp_max = std::numeric_limits<double>::max();
+
+    // results of a finite operation that overflowed are clamped to a finite
+    // value when rounding towards zero.
+    double clamp_up(double r) { return r == -fp_inf ? -fp_max : r; }
+    double clamp_down(double r) { return r == fp_inf ? fp_max : r; }
+
+    // a*b rounded towards +oo and -oo, with 0 * oo = 0
+    double fp_mul(double a, double b, bool up) {
+        if (a == 0 || b == 0)
+            return 0;
+        double p = a * b;
+        if (std::isinf(a) || std::isinf(b))
+            return p;
+        if (std::isinf(p))
+            return up ? clamp_up(p) : clamp_down(p);
+        double err = std::fabs(p) < 1e-280 ? (up ? 1 : -1) : std::fma(a, b, -p);
+        if (up && err > 0)
+            return std::nextafter(p, fp_inf);
+        if (!up && err < 0)
+            return std::nextafter(p, -fp_inf);
+        return p;
+    }
+
+    double fp_add(double a, double b, bool up) {
+        double s = a + b;
+        if (std::isinf(a) || std::isinf(b))
+            return s;
+        if (std::isinf(s))
+            return up ? clamp_up(s) : clamp_down(s);
+        double bb = s - a;
+        double err = (a - (s - bb)) + (b - bb);
+        if (up && err > 0)
+            return std::nextafter(s, fp_inf);
+        if (!up && err < 0)
+            return std::nextafter(s, -fp_inf);
+        return s;
+    }
+
+    // |x|^p rounded in the given direction
+    double fp_abs_pow(double x, unsigned p, bool up) {
+        x = std::fabs(x);
+        double r = 1;
+        for (unsigned i = 0; i < p; ++i)
+            r = fp_mul(r, x, up);
+        return r;
+    }
+
+    double fp_round(rational const& v, bool up) {
+        double d = v.get_double();
+        if (v.is_int() && std::fabs(d) < 9007199254740992.0)
+            return d;
+        if (std::isinf(d))
+            return up ? clamp_up(d) : clamp_down(d);
+        double delta = std::fabs(d) * 1e-15 + 1e-300;
+        return up ? d + delta : d - delta;
+    }
+}
+
 const nex* intervals::get_inf_interval_child(const nex_sum& e) const {
     for (auto * c : e) {
         if (has_inf_interval(*c))
@@ -79,9 +142,217 @@ std::ostream& intervals::display_separating_interval(std::ostream& out, const ne
           return out;
 }
 
+unsigned intervals::mk_tape_leaf(fp_interval const& i) {
+    tape_entry t;
+    t.m_op = tape_op::leaf;
+    t.m_arg = t.m_num_args = t.m_pow = 0;
+    t.m_value = i;
+    m_tape.push_back(t);
+    return m_tape.size() - 1;
+}
+
+// the inner approximation of the bounds of v: the lower bound is rounded up and the upper bound down
+intervals::fp_interval intervals::fp_var_interval(lpvar v) const {
+    fp_interval r = { -fp_inf, fp_inf };
+    lp::constraint_index ci;
+    rational val;
+    bool is_strict;
+    if (ls().has_lower_bound(v, ci, val, is_strict))
+        r.m_lo = fp_round(val, true);
+    if (ls().has_upper_bound(v, ci, val, is_strict))
+        r.m_hi = fp_round(val, false);
+    return r;
+}
+
+// mirrors interval_from_term. If a is not a double, i is set to an empty
+// interval so that the tape gives up on the intersection.
+bool intervals::fp_term_interval(const nex_sum& e, fp_interval& i) {
+    rational a, b;
+    lp::lar_term norm_t = expression_to_normalized_term(&e, a, b);
+    lp::explanation exp;
+    if (m_core->explain_by_equiv(norm_t, exp)) {
+        i = { fp_round(b, true), fp_round(b, false) };
+        return true;
+    }
+    lpvar j = find_term_column(norm_t, a);
+    if (j + 1 == 0)
+        return false;
+    fp_interval v = fp_var_interval(j);
+    double ca = fp_round(a, true);
+    if (ca != fp_round(a, false)) {
+        i = { fp_inf, -fp_inf };
+        return true;
+    }
+    double lo = std::min(fp_mul(ca, v.m_lo, true), fp_mul(ca, v.m_hi, true));
+    double hi = std::max(fp_mul(ca, v.m_lo, false), fp_mul(ca, v.m_hi, false));
+    i.m_lo = fp_add(lo, fp_round(b, true), true);
+    i.m_hi = fp_add(hi, fp_round(b, false), false);
+    return true;
+}
+
+/**
+   Append e^p to the tape following the case analysis of interval_of_expr.
+   Variable bounds and term intervals are read while flattening.
+   Return the index of the entry holding the result.
+*/
+unsigned intervals::flatten(const nex* e, unsigned p) {
+    unsigned r = UINT_MAX;
+    switch (e->type()) {
+    case expr_type::SCALAR: {
+        rational v = power(to_scalar(e)->value(), p);
+        return mk_tape_leaf({ fp_round(v, true), fp_round(v, false) });
+    }
+    case expr_type::VAR:
+        r = mk_tape_leaf(fp_var_interval(e->to_var().var()));
+        break;
+    case expr_type::SUM: {
+        const nex_sum& s = e->to_sum();
+        if (has_inf_interval(s))
+            r = mk_tape_leaf({ -fp_inf, fp_inf });
+        else {
+            unsigned_vector args;
+            for (const nex* c : s)
+                args.push_back(flatten(c, 1));
+            tape_entry t;
+            t.m_op = tape_op::add;
+            t.m_arg = m_tape_args.size();
+            t.m_num_args = args.size();
+            t.m_pow = 0;
+            m_tape_args.append(args);
+            m_tape.push_back(t);
+            r = m_tape.size() - 1;
+        }
+        fp_interval ti;
+        if (s.is_a_linear_term() && fp_term_interval(s, ti)) {
+            tape_entry t;
+            t.m_op = tape_op::intersect;
+            t.m_arg = r;
+            t.m_num_args = t.m_pow = 0;
+            t.m_value = ti;
+            m_tape.push_back(t);
+            r = m_tape.size() - 1;
+        }
+        break;
+    }
+    case expr_type::MUL: {
+        const nex_mul& m = e->to_mul();
+        const nex* zero_interval_child = get_zero_interval_child(m);
+        if (zero_interval_child) {
+            r = flatten(zero_interval_child, 1);
+            break;
+        }
+        unsigned_vector args;
+        args.push_back(mk_tape_leaf({ fp_round(m.coeff(), true), fp_round(m.coeff(), false) }));
+        for (const auto& ep : m)
+            args.push_back(flatten(ep.e(), ep.pow()));
+        tape_entry t;
+        t.m_op = tape_op::mul;
+        t.m_arg = m_tape_args.size();
+        t.m_num_args = args.size();
+        t.m_pow = 0;
+        m_tape_args.append(args);
+        m_tape.push_back(t);
+        r = m_tape.size() - 1;
+        break;
+    }
+    default:
+        UNREACHABLE();
+    }
+    if (p != 1) {
+        tape_entry t;
+        t.m_op = tape_op::power;
+        t.m_arg = r;
+        t.m_num_args = 0;
+        t.m_pow = p;
+        m_tape.push_back(t);
+        r = m_tape.size() - 1;
+    }
+    return r;
+}
+
+/**
+   Evaluate the tape. Every entry is an inner approximation of the interval
+   computed by exact interval arithmetic: lower bounds are rounded up and upper
+   bounds are rounded down. Return false if an inner approximation does not
+   exist, or if an intersection might be empty, in which case the exact
+   evaluation might produce a lemma.
+*/
+bool intervals::eval_tape(fp_interval& r) {
+    m_tape_values.reset();
+    for (tape_entry const& t : m_tape) {
+        fp_interval v;
+        switch (t.m_op) {
+        case tape_op::leaf:
+            v = t.m_value;
+            break;
+        case tape_op::add:
+            v = m_tape_values[m_tape_args[t.m_arg]];
+            for (unsigned k = 1; k < t.m_num_args; ++k) {
+                fp_interval const& b = m_tape_values[m_tape_args[t.m_arg + k]];
+                v.m_lo = fp_add(v.m_lo, b.m_lo, true);
+                v.m_hi = fp_add(v.m_hi, b.m_hi, false);
+            }
+            break;
+        case tape_op::mul:
+            v = m_tape_values[m_tape_args[t.m_arg]];
+            for (unsigned k = 1; k < t.m_num_args; ++k) {
+                fp_interval const& b = m_tape_values[m_tape_args[t.m_arg + k]];
+                double x[2] = { v.m_lo, v.m_hi }, y[2] = { b.m_lo, b.m_hi };
+                v.m_lo = fp_inf;
+                v.m_hi = -fp_inf;
+                for (double xi : x)
+                    for (double yi : y) {
+                        v.m_lo = std::min(v.m_lo, fp_mul(xi, yi, true));
+                        v.m_hi = std::max(v.m_hi, fp_mul(xi, yi, false));
+                    }
+            }
+            break;
+        case tape_op::power: {
+            fp_interval const& a = m_tape_values[t.m_arg];
+            if (t.m_pow % 2 == 1) {
+                v.m_lo = a.m_lo >= 0 ? fp_abs_pow(a.m_lo, t.m_pow, true) : -fp_abs_pow(a.m_lo, t.m_pow, false);
+                v.m_hi = a.m_hi >= 0 ? fp_abs_pow(a.m_hi, t.m_pow, false) : -fp_abs_pow(a.m_hi, t.m_pow, true);
+            }
+            else if (a.m_lo >= 0) 
+                v = { fp_abs_pow(a.m_lo, t.m_pow, true), fp_abs_pow(a.m_hi, t.m_pow, false) };
+            else if (a.m_hi <= 0) 
+                v = { fp_abs_pow(a.m_hi, t.m_pow, true), fp_abs_pow(a.m_lo, t.m_pow, false) };
+            else 
+                v = { 0, fp_abs_pow(std::max(-a.m_lo, a.m_hi), t.m_pow, false) };
+            break;
+        }
+        case tape_op::intersect: {
+            fp_interval const& a = m_tape_values[t.m_arg];
+            v = { std::max(a.m_lo, t.m_value.m_lo), std::min(a.m_hi, t.m_value.m_hi) };
+            if (!(v.m_lo < v.m_hi))
+                return false;
+            break;
+        }
+        }
+        if (!(v.m_lo <= v.m_hi))
+            return false;
+        m_tape_values.push_back(v);
+    }
+    r = m_tape_values.back();
+    return true;
+}
+
+// return true if the interval computed for e by interval_of_expr certainly contains 0 in its interior
+bool intervals::fp_contains_zero(const nex* e) {
+    m_tape.reset();
+    m_tape_args.reset();
+    flatten(e, 1);
+    fp_interval r;
+    return eval_tape(r) && r.m_lo < 0 && 0 < r.m_hi;
+}
+
 // return true iff the interval of n is does not contain 0
 bool intervals::check_nex(const nex* n, u_dependency* initial_deps) {
     m_core->lp_settings().stats().m_cross_nested_forms++;
+    if (m_core->m_nla_settings.horner_fp_filter() && fp_contains_zero(n)) {
+        m_core->lp_settings().stats().m_cross_nested_forms_fp++;
+        return false;
+    }
     scoped_dep_interval i(get_dep_intervals());
     std::function<void (const lp::explanation&)> f = [this](const lp::explanation& e) {
         new_lemma lemma(*m_core, "check_nex");
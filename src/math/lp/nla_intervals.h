@@ -21,6 +21,24 @@ class core;
 class intervals {
     mutable dep_intervals     m_dep_intervals;
     core*                     m_core;
+
+    // A nex expression flattened into a tape in post order.
+    // The tape computes an inner approximation, in doubles, of the interval
+    // that interval_of_expr computes without dependencies.
+    struct fp_interval {
+        double m_lo, m_hi;
+    };
+    enum class tape_op { leaf, add, mul, power, intersect };
+    struct tape_entry {
+        tape_op     m_op;
+        unsigned    m_arg;      // first argument in m_tape_args, or the argument for power and intersect
+        unsigned    m_num_args;
+        unsigned    m_pow;
+        fp_interval m_value;    // for leaf and intersect
+    };
+    svector<tape_entry>       m_tape;
+    unsigned_vector           m_tape_args;
+    svector<fp_interval>      m_tape_values;
     
 public:
     typedef dep_intervals::interval interval;
@@ -29,6 +47,12 @@ private:
     u_dependency* mk_dep(lp::explanation const&);
     lp::lar_solver& ls();
     const lp::lar_solver& ls() const;
+    unsigned mk_tape_leaf(fp_interval const& i);
+    fp_interval fp_var_interval(lpvar v) const;
+    bool fp_term_interval(const nex_sum& e, fp_interval& i);
+    unsigned flatten(const nex* e, unsigned p);
+    bool eval_tape(fp_interval& r);
+    bool fp_contains_zero(const nex* e);
 public:
 
     intervals(core* c, reslimit& lim) :
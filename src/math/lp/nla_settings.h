@@ -17,6 +17,7 @@ class nla_settings {
     unsigned m_horner_frequency;
     unsigned m_horner_row_length_limit;
     unsigned m_horner_subs_fixed;
+    bool     m_horner_fp_filter;
     // grobner fields
     bool     m_run_grobner;
     unsigned m_grobner_row_length_limit;
@@ -29,6 +30,7 @@ class nla_settings {
     unsigned m_grobner_number_of_conflicts_to_report;
     unsigned m_grobner_quota;
     unsigned m_grobner_frequency;
+    unsigned m_grobner_threads;
     bool     m_run_nra;
     // expensive patching
     bool     m_expensive_patching;
@@ -39,11 +41,13 @@ public:
                      m_horner_frequency(4),
                      m_horner_row_length_limit(10),
                      m_horner_subs_fixed(2),
+                     m_horner_fp_filter(false),
                      m_run_grobner(true),
                      m_grobner_row_length_limit(50),
                      m_grobner_subs_fixed(false),
                      m_grobner_quota(0),
                      m_grobner_frequency(4),
+                     m_grobner_threads(1),
                      m_run_nra(false),
                      m_expensive_patching(false)
     {}
@@ -67,6 +71,8 @@ public:
     unsigned& horner_row_length_limit() { return m_horner_row_length_limit; }    
     unsigned horner_subs_fixed() const { return m_horner_subs_fixed; }
     unsigned& horner_subs_fixed() { return m_horner_subs_fixed; }
+    bool horner_fp_filter() const { return m_horner_fp_filter; }
+    bool& horner_fp_filter() { return m_horner_fp_filter; }
 
     bool run_grobner() const { return m_run_grobner; }
     bool& run_grobner() { return m_run_grobner; }
@@ -97,6 +103,9 @@ public:
     unsigned & grobner_number_of_conflicts_to_report() { return m_grobner_number_of_conflicts_to_report; }
 
     unsigned& grobner_quota() { return m_grobner_quota; }
+
+    unsigned grobner_threads() const { return m_grobner_threads; }
+    unsigned & grobner_threads() { return m_grobner_threads; }
     
 };
 }
@@ -22,6 +22,7 @@ Notes:
 #include "util/mpbqi.h"
 #include "util/timeit.h"
 #include "util/common_msgs.h"
+#include <cmath>
 #include "math/polynomial/algebraic_numbers.h"
 #include "math/polynomial/upolynomial.h"
 #include "math/polynomial/sexpr2upolynomial.h"
@@ -89,9 +90,14 @@ namespace algebraic_numbers {
         bool                       m_factor;
         polynomial::factor_params  m_factor_params;
         int                        m_zero_accuracy;
+        bool                       m_fp_filter;
+
+        svector<double>          m_fp_p_a;
+        svector<double>          m_fp_p_b;
 
         // statistics
         unsigned                 m_compare_cheap;
+        unsigned                 m_compare_fp;
         unsigned                 m_compare_sturm;
         unsigned                 m_compare_refine;
         unsigned                 m_compare_poly_eq;
@@ -136,6 +142,7 @@ namespace algebraic_numbers {
 
         void reset_statistics() {
             m_compare_cheap   = 0;
+            m_compare_fp      = 0;
             m_compare_sturm   = 0;
             m_compare_refine  = 0;
             m_compare_poly_eq = 0;
@@ -144,6 +151,7 @@ namespace algebraic_numbers {
         void collect_statistics(statistics & st) {
 #ifndef _EXTERNAL_RELEASE
             st.update("algebraic compare cheap", m_compare_cheap);
+            st.update("algebraic compare fp", m_compare_fp);
             st.update("algebraic compare sturm", m_compare_sturm);
             st.update("algebraic compare refine", m_compare_refine);
             st.update("algebraic compare poly", m_compare_poly_eq);
@@ -158,6 +166,7 @@ namespace algebraic_numbers {
             m_factor_params.m_p_trials = p.factor_num_primes();
             m_factor_params.m_max_search_size = p.factor_search_size();
             m_zero_accuracy            = -static_cast<int>(p.zero_accuracy());
+            m_fp_filter                = p.fp_filter();
         }
 
         unsynch_mpq_manager & qm() {
@@ -1753,6 +1762,143 @@ namespace algebraic_numbers {
             return sign_b == sign_lower(c) ? sign_pos : sign_neg;
         }
 
+        /**
+           \brief Store in r the value of the binary rational a as a double.
+           Return false if the conversion is not exact.
+        */
+        bool to_double(mpbq const & a, double & r) {
+            mpz const & n = a.numerator();
+            if (!qm().is_int64(n) || a.k() > 1000)
+                return false;
+            int64_t v = qm().get_int64(n);
+            if (v > (static_cast<int64_t>(1) << 53) || v < -(static_cast<int64_t>(1) << 53))
+                return false;
+            r = std::ldexp(static_cast<double>(v), -static_cast<int>(a.k()));
+            return true;
+        }
+
+        /**
+           \brief Store the double d in r. The conversion is always exact.
+        */
+        void to_mpbq(double d, mpbq & r) {
+            int e;
+            double f = std::frexp(d, &e);
+            scoped_mpz n(qm());
+            qm().set(n, static_cast<int64_t>(std::ldexp(f, 53)));
+            e -= 53;
+            if (e >= 0) {
+                qm().mul2k(n, e);
+                bqm().set(r, n, 0);
+            }
+            else {
+                bqm().set(r, n, -e);
+            }
+        }
+
+        /**
+           \brief Store in r the coefficients of the polynomial of c as doubles.
+           Return false if some coefficient does not fit in a double.
+        */
+        bool to_double(algebraic_cell const * c, svector<double> & r) {
+            r.reset();
+            for (unsigned i = 0; i < c->m_p_sz; i++) {
+                double d = qm().get_double(c->m_p[i]);
+                if (!std::isfinite(d))
+                    return false;
+                r.push_back(d);
+            }
+            return true;
+        }
+
+        /**
+           \brief Return the sign of p(x) if it can be certified using double
+           precision arithmetic, and sign_zero otherwise.
+
+           The rounding error of the Horner evaluation (plus the conversion of
+           the coefficients to double) is bounded by gamma(2n + 1) * sum |p_i| |x|^i,
+           where gamma(k) = k*u/(1 - k*u) and u = 2^-53.
+           We use gamma(4n + 4) to also cover the rounding error of the bound itself.
+        */
+        static ::sign fp_sign_at(svector<double> const & p, double x) {
+            unsigned n = p.size();
+            SASSERT(n > 0);
+            double v = p[n - 1];
+            double b = std::fabs(p[n - 1]);
+            double ax = std::fabs(x);
+            for (unsigned i = n - 1; i-- > 0; ) {
+                v = v * x + p[i];
+                b = b * ax + std::fabs(p[i]);
+            }
+            if (!std::isfinite(b))
+                return sign_zero;
+            double ku = (4.0 * n + 4.0) * std::ldexp(1.0, -53);
+            double err = (ku / (1.0 - ku)) * b;
+            if (v > err)
+                return sign_pos;
+            if (v < -err)
+                return sign_neg;
+            return sign_zero;
+        }
+
+        /**
+           \brief Try to separate the isolating intervals of a and b by bisection using
+           double precision arithmetic. The sign of each midpoint is certified by fp_sign_at,
+           so the refined intervals are stored back into a and b.
+
+           Return true if the intervals were separated, and store the result of the
+           comparison in r. Return false if the intervals or coefficients are not representable
+           as doubles, or the sign of a midpoint could not be certified.
+        */
+        bool fp_compare(algebraic_cell * a, algebraic_cell * b, ::sign & r) {
+            double la, ua, lb, ub;
+            if (!to_double(lower(a), la) || !to_double(upper(a), ua) ||
+                !to_double(lower(b), lb) || !to_double(upper(b), ub))
+                return false;
+            if (!to_double(a, m_fp_p_a) || !to_double(b, m_fp_p_b))
+                return false;
+            ::sign sa = sign_lower(a);
+            ::sign sb = sign_lower(b);
+            bool a_refined = false, b_refined = false;
+            bool found = false;
+            while (true) {
+                if (ua <= lb) {
+                    r = sign_neg;
+                    found = true;
+                    break;
+                }
+                if (la >= ub) {
+                    r = sign_pos;
+                    found = true;
+                    break;
+                }
+                bool on_a = (ua - la) >= (ub - lb);
+                double & l = on_a ? la : lb;
+                double & u = on_a ? ua : ub;
+                double mid = l / 2 + u / 2;
+                if (!(l < mid && mid < u))
+                    break;
+                ::sign s = fp_sign_at(on_a ? m_fp_p_a : m_fp_p_b, mid);
+                if (s == sign_zero)
+                    break;
+                if (s == (on_a ? sa : sb))
+                    l = mid;
+                else
+                    u = mid;
+                (on_a ? a_refined : b_refined) = true;
+            }
+            if (a_refined) {
+                to_mpbq(la, lower(a));
+                to_mpbq(ua, upper(a));
+                SASSERT(acell_inv(*a));
+            }
+            if (b_refined) {
+                to_mpbq(lb, lower(b));
+                to_mpbq(ub, upper(b));
+                SASSERT(acell_inv(*b));
+            }
+            return found;
+        }
+
         // Return true if the polynomials of cell_a and cell_b are the same.
         bool compare_p(algebraic_cell const * cell_a, algebraic_cell const * cell_b) {
             return upm().eq(cell_a->m_p_sz, cell_a->m_p, cell_b->m_p_sz, cell_b->m_p);
@@ -1787,6 +1933,17 @@ namespace algebraic_numbers {
                 return sign_zero;
             }
 
+            // Cheap filter: refine the intervals using double precision arithmetic.
+            // The exact procedures below are only used if it is inconclusive.
+            if (m_fp_filter) {
+                ::sign r;
+                if (fp_compare(cell_a, cell_b, r)) {
+                    m_compare_fp++;
+                    return r;
+                }
+                COMPARE_INTERVAL();
+            }
+
             TRACE("algebraic", tout << "comparing\n";
                   tout << "a: "; upm().display(tout, cell_a->m_p_sz, cell_a->m_p); tout << "\n"; bqim().display(tout, cell_a->m_interval);
                   tout << "\ncell_a->m_minimal: " << cell_a->m_minimal << "\n";
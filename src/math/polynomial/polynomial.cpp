@@ -3751,13 +3751,36 @@ namespace polynomial {
             m().neg(lower);
             TRACE("CRA", tout << "lower: " << lower << ", upper: " << upper << "\n";);
 
+            // When b1 is a word-sized prime (the common case), use Garner's formula
+            //     new_a = A2 + b2*(((A1 - A2) mod b1)*inv2 mod b1)
+            // It only needs remainders and products by single words, instead of
+            // the products by a1 and a2 and the remainder modulo new_bound.
+            bool     small_b1 = m().m().is_uint(b1);
+            uint64_t p1   = small_b1 ? m().m().get_uint64(b1) : 0;
+            uint64_t inv  = small_b1 ? m().m().get_uint64(inv2) : 0;
+            auto combine = [&](numeral const & A1, numeral const & A2) {
+                if (small_b1) {
+                    m().m().mod(A1, b1, tmp1);
+                    m().m().mod(A2, b1, tmp2);
+                    uint64_t t = (m().m().get_uint64(tmp1) + p1 - m().m().get_uint64(tmp2)) % p1;
+                    m().m().set(tmp3, (t * inv) % p1);
+                    m().m().mul(b2, tmp3, tmp1);
+                    m().m().add(A2, tmp1, new_a);
+                    if (m().m().lt(new_a, lower))
+                        m().m().add(new_a, new_bound, new_a);
+                }
+                else {
+                    m().mul(A1, a1, tmp1);
+                    m().mul(A2, a2, tmp2);
+                    m().add(tmp1, tmp2, tmp3);
+                    m().m().mod(tmp3, new_bound, new_a);
+                }
+                if (m().gt(new_a, upper))
+                    m().sub(new_a, new_bound, new_a);
+            };
+
             #define ADD(A1, A2, M) {                    \
-                m().mul(A1, a1, tmp1);                  \
-                m().mul(A2, a2, tmp2);                  \
-                m().add(tmp1, tmp2, tmp3);              \
-                m().m().mod(tmp3, new_bound, new_a);    \
-                if (m().gt(new_a, upper))               \
-                    m().sub(new_a, new_bound, new_a);   \
+                combine(A1, A2);                        \
                 R.add(new_a, M);                        \
             }
 
@@ -3809,6 +3832,30 @@ namespace polynomial {
             r  = R.mk();
         }
 
+        /**
+           \brief Return true if the image C of the GCD modulo bound is worth the
+           trial divisions over Z. This is the case when adding the last prime did
+           not change it (i.e., C == prev), or when its coefficients are much
+           smaller than bound. A bad image has coefficients spread over
+           (-bound/2, bound/2), and trial division is much more expensive than
+           computing another modular image.
+        */
+        bool is_stable_image(polynomial const * prev, polynomial const * C, numeral const & bound) {
+            if (prev != nullptr && eq(prev, C))
+                return true;
+            scoped_numeral threshold(m());
+            scoped_numeral a(m());
+            m().m().machine_div2k(bound, 8, threshold);
+            unsigned sz = C->size();
+            for (unsigned i = 0; i < sz; i++) {
+                m().m().set(a, C->a(i));
+                m().m().abs(a);
+                if (m().m().gt(a, threshold))
+                    return false;
+            }
+            return true;
+        }
+
         void uni_mod_gcd(polynomial const * u, polynomial const * v, polynomial_ref & r) {
             TRACE("mgcd", tout << "univ_modular_gcd\nu: "; u->display(tout, m_manager); tout << "\nv: "; v->display(tout, m_manager); tout << "\n";);
             SASSERT(!m().modular());
@@ -3841,10 +3888,12 @@ namespace polynomial {
             polynomial_ref q(m_wrapper);
 
             polynomial_ref candidate(m_wrapper);
+            polynomial_ref prev(m_wrapper);
 
             scoped_numeral p(m());
             for (unsigned i = 0; i < NUM_BIG_PRIMES; i++) {
                 m().set(p, g_big_primes[i]);
+                prev.reset();
                 TRACE("mgcd", tout << "trying prime: " << p << "\n";);
                 {
                     scoped_set_zp setZp(m_wrapper, p);
@@ -3886,10 +3935,15 @@ namespace polynomial {
                         m().set(bound, p);
                     }
                     else {
+                        prev = C_star;
                         CRA_combine_images(q, p, C_star, bound, C_star);
                         TRACE("mgcd", tout << "new combined:\n" << C_star << "\n";);
                     }
                 }
+                if (!is_stable_image(prev, C_star, bound)) {
+                    TRACE("mgcd", tout << "image is not stable yet\n";);
+                    continue;
+                }
                 candidate = pp(C_star, x);
                 TRACE("mgcd", tout << "candidate:\n" << candidate << "\n";);
                 scoped_numeral lc_candidate(m());
@@ -4324,10 +4378,12 @@ namespace polynomial {
             scoped_numeral bound(m());
             polynomial_ref q(m_wrapper);
             polynomial_ref candidate(m_wrapper);
+            polynomial_ref prev(m_wrapper);
             scoped_numeral p(m());
 
             for (unsigned i = 0; i < NUM_BIG_PRIMES; i++) {
                 m().set(p, g_big_primes[i]);
+                prev.reset();
                 TRACE("mgcd", tout << "trying prime: " << p << "\n";);
                 {
                     scoped_set_zp setZp(m_wrapper, p);
@@ -4369,10 +4425,15 @@ namespace polynomial {
                         m().set(bound, p);
                     }
                     else {
+                        prev = C_star;
                         CRA_combine_images(q, p, C_star, bound, C_star);
                         TRACE("mgcd", tout << "new combined:\n" << C_star << "\n";);
                     }
                 }
+                if (!is_stable_image(prev, C_star, bound)) {
+                    TRACE("mgcd", tout << "image is not stable yet\n";);
+                    continue;
+                }
                 candidate = normalize(C_star);
                 TRACE("mgcd", tout << "candidate:\n" << candidate << "\n";);
                 scoped_numeral lc_candidate(m());
@@ -6984,6 +7045,10 @@ namespace polynomial {
         return m_imp->m_manager.m();
     }
 
+    reslimit & manager::limit() const {
+        return m_imp->m_limit;
+    }
+
     monomial_manager & manager::mm() const {
         return m_imp->mm();
     }
@@ -7060,6 +7125,10 @@ namespace polynomial {
             m_imp->dec_ref(p);
     }
 
+    unsigned manager::ref_count(polynomial const * p) {
+        return p->ref_count();
+    }
+
     void manager::lex_sort(polynomial * p) {
         m_imp->lex_sort(p);
     }
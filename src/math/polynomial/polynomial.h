@@ -197,6 +197,7 @@ namespace polynomial {
         ~manager();
 
         numeral_manager & m() const;
+        reslimit & limit() const;
         monomial_manager & mm() const;
         small_object_allocator & allocator() const;
 
@@ -266,6 +267,11 @@ namespace polynomial {
         void dec_ref(polynomial * p);
         void dec_ref(monomial * m);
 
+        /**
+           \brief Return the reference counter of \c p.
+        */
+        static unsigned ref_count(polynomial const * p);
+
         /**
            \brief Return an unique id associated with \c m.
            This id can be used to implement efficient mappings from monomial to data.
@@ -16,8 +16,10 @@ Author:
 Notes:
 
 --*/
+#include <algorithm>
 #include "math/polynomial/polynomial_cache.h"
 #include "util/chashtable.h"
+#include "util/statistics.h"
 
 namespace polynomial {
 
@@ -40,6 +42,7 @@ namespace polynomial {
         unsigned           m_hash;
         unsigned           m_result_sz;
         polynomial **      m_result;
+        unsigned           m_last_used;
         
         psc_chain_entry(polynomial const * p, polynomial const * q, var x, unsigned h):
             m_p(p),
@@ -47,7 +50,8 @@ namespace polynomial {
             m_x(x),
             m_hash(h),
             m_result_sz(0),
-            m_result(nullptr) {
+            m_result(nullptr),
+            m_last_used(0) {
         }
         
         struct hash_proc { unsigned operator()(psc_chain_entry const * entry) const { return entry->m_hash; } };
@@ -64,12 +68,14 @@ namespace polynomial {
         unsigned           m_hash;
         unsigned           m_result_sz;
         polynomial **      m_result;
+        unsigned           m_last_used;
         
         factor_entry(polynomial const * p, unsigned h):
             m_p(p),
             m_hash(h),
             m_result_sz(0),
-            m_result(nullptr) {
+            m_result(nullptr),
+            m_last_used(0) {
         }
         
         struct hash_proc { unsigned operator()(factor_entry const * entry) const { return entry->m_hash; } };
@@ -93,8 +99,12 @@ namespace polynomial {
         polynomial_ref_vector    m_cached_polys;
         svector<char>            m_in_cache;
         small_object_allocator & m_allocator;
+        unsigned                 m_max_entries;
+        unsigned                 m_timestamp;
+        cache::stats             m_stats;
 
-        imp(manager & _m):m(_m), m_poly_table(poly_hash_proc(m), poly_eq_proc(m)), m_cached_polys(m), m_allocator(m.allocator()) {
+        imp(manager & _m):m(_m), m_poly_table(poly_hash_proc(m), poly_eq_proc(m)), m_cached_polys(m), m_allocator(m.allocator()),
+            m_max_entries(UINT_MAX), m_timestamp(0) {
         }
         
         ~imp() {
@@ -135,6 +145,74 @@ namespace polynomial {
         }
 
         unsigned pid(polynomial * p) const { return m.id(p); }
+
+        /**
+           \brief Evict the least recently used half of the psc chain and factor
+           entries when there are more than m_max_entries of them.
+           Afterwards, the hash-consed polynomials that are neither used by the
+           remaining entries nor referenced outside of the cache are released.
+        */
+        void gc() {
+            unsigned num_entries = m_psc_chain_cache.size() + m_factor_cache.size();
+            if (num_entries <= m_max_entries)
+                return;
+            unsigned_vector stamps;
+            for (psc_chain_entry * e : m_psc_chain_cache)
+                stamps.push_back(e->m_last_used);
+            for (factor_entry * e : m_factor_cache)
+                stamps.push_back(e->m_last_used);
+            unsigned num_keep = m_max_entries / 2;
+            unsigned mid = stamps.size() - num_keep;
+            std::nth_element(stamps.begin(), stamps.begin() + mid, stamps.end());
+            unsigned threshold = stamps[mid];
+            ptr_buffer<psc_chain_entry> old_pscs;
+            for (psc_chain_entry * e : m_psc_chain_cache)
+                if (e->m_last_used < threshold)
+                    old_pscs.push_back(e);
+            for (psc_chain_entry * e : old_pscs) {
+                m_psc_chain_cache.erase(e);
+                del_psc_chain_entry(e);
+            }
+            ptr_buffer<factor_entry> old_factors;
+            for (factor_entry * e : m_factor_cache)
+                if (e->m_last_used < threshold)
+                    old_factors.push_back(e);
+            for (factor_entry * e : old_factors) {
+                m_factor_cache.erase(e);
+                del_factor_entry(e);
+            }
+            m_stats.m_evictions += old_pscs.size() + old_factors.size();
+            release_unused_polys();
+        }
+
+        void release_unused_polys() {
+            svector<char> used;
+            auto mark = [&](polynomial const * p) { used.setx(m.id(p), true, false); };
+            for (psc_chain_entry * e : m_psc_chain_cache) {
+                mark(e->m_p);
+                mark(e->m_q);
+                for (unsigned i = 0; i < e->m_result_sz; i++)
+                    mark(e->m_result[i]);
+            }
+            for (factor_entry * e : m_factor_cache) {
+                mark(e->m_p);
+                for (unsigned i = 0; i < e->m_result_sz; i++)
+                    mark(e->m_result[i]);
+            }
+            unsigned j = 0;
+            for (unsigned i = 0; i < m_cached_polys.size(); i++) {
+                polynomial * p = m_cached_polys.get(i);
+                // m_cached_polys holds one reference
+                if (used.get(pid(p), false) || manager::ref_count(p) > 1) {
+                    m_cached_polys.set(j++, p);
+                    continue;
+                }
+                m_poly_table.erase(p);
+                m_in_cache[pid(p)] = false;
+                m_stats.m_released_polys++;
+            }
+            m_cached_polys.shrink(j);
+        }
         
         polynomial * mk_unique(polynomial * p) {
             if (m_in_cache.get(pid(p), false))
@@ -161,8 +239,12 @@ namespace polynomial {
                 for (unsigned i = 0; i < old_entry->m_result_sz; i++) {
                     S.push_back(old_entry->m_result[i]);
                 }
+                old_entry->m_last_used = ++m_timestamp;
+                m_stats.m_psc_hits++;
             }
             else {
+                m_stats.m_psc_misses++;
+                entry->m_last_used = ++m_timestamp;
                 m.psc_chain(p, q, x, S);
                 unsigned sz = S.size();
                 entry->m_result_sz = sz;
@@ -172,9 +254,38 @@ namespace polynomial {
                     S.set(i, h);
                     entry->m_result[i] = h;
                 }
+                gc();
             }
         }
 
+        bool contains_psc_chain(polynomial * p, polynomial * q, var x) {
+            p = mk_unique(p);
+            q = mk_unique(q);
+            psc_chain_entry key(p, q, x, hash_u_u(pid(p), pid(q)));
+            return m_psc_chain_cache.contains(&key);
+        }
+
+        void set_psc_chain(polynomial * p, polynomial * q, var x, polynomial_ref_vector const & S) {
+            p = mk_unique(p);
+            q = mk_unique(q);
+            unsigned h = hash_u_u(pid(p), pid(q));
+            psc_chain_entry * entry = new (m_allocator.allocate(sizeof(psc_chain_entry))) psc_chain_entry(p, q, x, h);
+            psc_chain_entry * old_entry = m_psc_chain_cache.insert_if_not_there(entry); 
+            if (entry != old_entry) {
+                entry->~psc_chain_entry();
+                m_allocator.deallocate(sizeof(psc_chain_entry), entry);
+                return;
+            }
+            m_stats.m_psc_prefetched++;
+            entry->m_last_used = ++m_timestamp;
+            unsigned sz = S.size();
+            entry->m_result_sz = sz;
+            entry->m_result    = static_cast<polynomial**>(m_allocator.allocate(sizeof(polynomial*)*sz));
+            for (unsigned i = 0; i < sz; i++) 
+                entry->m_result[i] = mk_unique(S.get(i));
+            gc();
+        }
+
         void factor(polynomial * p, polynomial_ref_vector & distinct_factors) {
             distinct_factors.reset();
             p = mk_unique(p);
@@ -188,8 +299,12 @@ namespace polynomial {
                 for (unsigned i = 0; i < old_entry->m_result_sz; i++) {
                     distinct_factors.push_back(old_entry->m_result[i]);
                 }
+                old_entry->m_last_used = ++m_timestamp;
+                m_stats.m_factor_hits++;
             }
             else {
+                m_stats.m_factor_misses++;
+                entry->m_last_used = ++m_timestamp;
                 factors fs(m);
                 m.factor(p, fs);
                 unsigned sz = fs.distinct_factors();
@@ -200,6 +315,7 @@ namespace polynomial {
                     distinct_factors.push_back(h);
                     entry->m_result[i] = h;
                 }
+                gc();
             }
         }
     };
@@ -224,13 +340,44 @@ namespace polynomial {
         m_imp->psc_chain(const_cast<polynomial*>(p), const_cast<polynomial*>(q), x, S);
     }
 
+    bool cache::contains_psc_chain(polynomial const * p, polynomial const * q, var x) {
+        return m_imp->contains_psc_chain(const_cast<polynomial*>(p), const_cast<polynomial*>(q), x);
+    }
+
+    void cache::set_psc_chain(polynomial const * p, polynomial const * q, var x, polynomial_ref_vector const & S) {
+        m_imp->set_psc_chain(const_cast<polynomial*>(p), const_cast<polynomial*>(q), x, S);
+    }
+
     void cache::factor(polynomial const * p, polynomial_ref_vector & distinct_factors) {
         m_imp->factor(const_cast<polynomial*>(p), distinct_factors);
     }
     
     void cache::reset() {
         manager & _m = m();
+        unsigned max_entries = m_imp->m_max_entries;
+        stats st = m_imp->m_stats;
         dealloc(m_imp);
         m_imp = alloc(imp, _m);
+        m_imp->m_max_entries = max_entries;
+        m_imp->m_stats = st;
+    }
+
+    void cache::set_max_entries(unsigned n) {
+        m_imp->m_max_entries = n == 0 ? UINT_MAX : std::max(n, 2u);
+        m_imp->gc();
+    }
+
+    void cache::collect_statistics(statistics & st) const {
+        st.update("nlsat psc cache hits", m_imp->m_stats.m_psc_hits);
+        st.update("nlsat psc cache misses", m_imp->m_stats.m_psc_misses);
+        st.update("nlsat psc chains prefetched", m_imp->m_stats.m_psc_prefetched);
+        st.update("nlsat factor cache hits", m_imp->m_stats.m_factor_hits);
+        st.update("nlsat factor cache misses", m_imp->m_stats.m_factor_misses);
+        st.update("nlsat projection cache evictions", m_imp->m_stats.m_evictions);
+        st.update("nlsat projection cache released polynomials", m_imp->m_stats.m_released_polys);
+    }
+
+    void cache::reset_statistics() {
+        m_imp->m_stats.reset();
     }
 };
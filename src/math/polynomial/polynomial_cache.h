@@ -20,12 +20,27 @@ Notes:
 
 #include "math/polynomial/polynomial.h"
 
+class statistics;
+
 namespace polynomial {
 
     /**
        \brief Functor for creating unique polynomials and caching results of operations
     */
     class cache {
+    public:
+        struct stats {
+            unsigned m_psc_hits;
+            unsigned m_psc_misses;
+            unsigned m_psc_prefetched;
+            unsigned m_factor_hits;
+            unsigned m_factor_misses;
+            unsigned m_evictions;
+            unsigned m_released_polys;
+            stats() { reset(); }
+            void reset() { memset(this, 0, sizeof(*this)); }
+        };
+    private:
         struct imp;
         imp * m_imp;
     public:
@@ -35,8 +50,22 @@ namespace polynomial {
         manager & pm() const { return m(); }
         polynomial * mk_unique(polynomial * p);
         void psc_chain(polynomial const * p, polynomial const * q, var x, polynomial_ref_vector & S);
+        bool contains_psc_chain(polynomial const * p, polynomial const * q, var x);
+        /**
+           \brief Store S as the psc chain of p and q, computed elsewhere.
+           Existing entries are kept.
+        */
+        void set_psc_chain(polynomial const * p, polynomial const * q, var x, polynomial_ref_vector const & S);
         void factor(polynomial const * p, polynomial_ref_vector & distinct_factors);
         void reset();
+        /**
+           \brief Bound the number of cached psc chains and factorizations.
+           When the bound is exceeded, the least recently used half is evicted.
+           The bound 0 means no bound.
+        */
+        void set_max_entries(unsigned n);
+        void collect_statistics(statistics & st) const;
+        void reset_statistics();
     };
 };
 
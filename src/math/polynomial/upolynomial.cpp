@@ -689,13 +689,34 @@ namespace upolynomial {
         m().neg(lower);
         TRACE("CRA", tout << "lower: " << lower << ", upper: " << upper << "\n";);
 
+        // When b1 is a word-sized prime, use Garner's formula (see polynomial.cpp)
+        //     new_a = A2 + b2*(((A1 - A2) mod b1)*inv2 mod b1)
+        bool     small_b1 = m().m().is_uint(b1);
+        uint64_t p1   = small_b1 ? m().m().get_uint64(b1) : 0;
+        uint64_t inv  = small_b1 ? m().m().get_uint64(inv2) : 0;
+        auto combine = [&](numeral const & A1, numeral const & A2) {
+            if (small_b1) {
+                m().m().mod(A1, b1, tmp1);
+                m().m().mod(A2, b1, tmp2);
+                uint64_t t = (m().m().get_uint64(tmp1) + p1 - m().m().get_uint64(tmp2)) % p1;
+                m().m().set(tmp3, (t * inv) % p1);
+                m().m().mul(b2, tmp3, tmp1);
+                m().m().add(A2, tmp1, new_a);
+                if (m().m().lt(new_a, lower))
+                    m().m().add(new_a, new_bound, new_a);
+            }
+            else {
+                m().mul(A1, a1, tmp1);
+                m().mul(A2, a2, tmp2);
+                m().add(tmp1, tmp2, tmp3);
+                m().m().mod(tmp3, new_bound, new_a);
+            }
+            if (m().gt(new_a, upper))
+                m().sub(new_a, new_bound, new_a);
+        };
+
         #define ADD(A1, A2) {                           \
-            m().mul(A1, a1, tmp1);                      \
-            m().mul(A2, a2, tmp2);                      \
-            m().add(tmp1, tmp2, tmp3);                  \
-            m().m().mod(tmp3, new_bound, new_a);        \
-            if (m().gt(new_a, upper))                   \
-                m().sub(new_a, new_bound, new_a);       \
+            combine(A1, A2);                            \
             R.push_back(numeral());                     \
             m().set(R.back(), new_a);                   \
         }
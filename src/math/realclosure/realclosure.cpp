@@ -401,6 +401,22 @@ namespace realclosure {
 
         bool                           m_in_aux_values; // True if we are computing SquareFree polynomials or Sturm sequences. That is, the values being computed will be discarded.
 
+        // Cache for the results of arithmetic operations and comparisons requested by clients.
+        // Values are only updated destructively when they are not shared, and an entry holds
+        // references to its arguments and result. So, the addresses of the arguments identify
+        // an operation. The cache is direct mapped: an entry is evicted by the next operation
+        // that maps to the same slot.
+        enum cached_op { add_op, sub_op, mul_op, div_op, compare_op, no_op };
+        struct cache_entry {
+            cached_op m_op = no_op;
+            value *   m_a = nullptr;
+            value *   m_b = nullptr;
+            value *   m_r = nullptr;
+            int       m_cmp = 0;
+        };
+        svector<cache_entry>           m_op_cache;
+        unsigned                       m_num_cache_hits = 0;
+
 
         struct scoped_polynomial_seq {
             typedef ref_buffer<value, imp, REALCLOSURE_INI_SEQ_SIZE> value_seq;
@@ -520,6 +536,7 @@ namespace realclosure {
         }
 
         ~imp() {
+            reset_op_cache();
             restore_saved_intervals(); // to free memory
             dec_ref(m_one);
             dec_ref(m_pi);
@@ -738,6 +755,11 @@ namespace realclosure {
             m_inf_precision      = p.inf_precision();
             m_max_precision      = p.max_precision();
             m_lazy_algebraic_normalization = p.lazy_algebraic_normalization();
+            if (p.cache_size() != m_op_cache.size()) {
+                reset_op_cache();
+                m_op_cache.reset();
+                m_op_cache.resize(p.cache_size(), cache_entry());
+            }
             bqm().power(mpbq(2), m_inf_precision, m_plus_inf_approx);
             bqm().set(m_minus_inf_approx, m_plus_inf_approx);
             bqm().neg(m_minus_inf_approx);
@@ -2594,6 +2616,8 @@ namespace realclosure {
         template<typename T>
         void update_mpq_value(value * a, T & v) {
             SASSERT(is_nz_rational(a));
+            // only values that are not shared are updated, in particular no value held by m_op_cache
+            SASSERT(is_unique(a));
             qm().set(to_mpq(a), v);
             reset_interval(a);
         }
@@ -5597,28 +5621,87 @@ namespace realclosure {
             set(b, r);
         }
 
-        void add(numeral const & a, numeral const & b, numeral & c) {
+        void reset_entry(cache_entry & e) {
+            if (e.m_op == no_op)
+                return;
+            e.m_op = no_op;
+            dec_ref(e.m_a);
+            dec_ref(e.m_b);
+            dec_ref(e.m_r);
+        }
+
+        void reset_op_cache() {
+            for (cache_entry & e : m_op_cache)
+                reset_entry(e);
+        }
+
+        /**
+           \brief Return the cache slot for op(a, b), or nullptr if the result is not worth caching.
+           Operations on rationals are cheap and are not cached.
+        */
+        cache_entry * get_slot(cached_op op, value * a, value * b) {
+            if (m_op_cache.empty())
+                return nullptr;
+            if ((is_zero(a) || is_nz_rational(a)) && (is_zero(b) || is_nz_rational(b)))
+                return nullptr;
+            unsigned h = mk_mix(op, 
+                                static_cast<unsigned>(reinterpret_cast<size_t>(a) >> 3), 
+                                static_cast<unsigned>(reinterpret_cast<size_t>(b) >> 3));
+            return &m_op_cache[h % m_op_cache.size()];
+        }
+
+        static bool is_hit(cache_entry const * e, cached_op op, value * a, value * b) {
+            return e && e->m_op == op && e->m_a == a && e->m_b == b;
+        }
+
+        void set_entry(cache_entry * e, cached_op op, value * a, value * b, value * r, int cmp) {
+            if (!e)
+                return;
+            inc_ref(a);
+            inc_ref(b);
+            inc_ref(r);
+            reset_entry(*e);
+            e->m_op = op;
+            e->m_a = a;
+            e->m_b = b;
+            e->m_r = r;
+            e->m_cmp = cmp;
+        }
+
+        void apply(cached_op op, numeral const & a, numeral const & b, numeral & c) {
+            cache_entry * e = get_slot(op, a.m_value, b.m_value);
             value_ref r(*this);
-            add(a.m_value, b.m_value, r);
+            if (is_hit(e, op, a.m_value, b.m_value)) {
+                m_num_cache_hits++;
+                r = e->m_r;
+                set(c, r);
+                return;
+            }
+            switch (op) {
+            case add_op: add(a.m_value, b.m_value, r); break;
+            case sub_op: sub(a.m_value, b.m_value, r); break;
+            case mul_op: mul(a.m_value, b.m_value, r); break;
+            case div_op: div(a.m_value, b.m_value, r); break;
+            default: UNREACHABLE(); break;
+            }
+            set_entry(e, op, a.m_value, b.m_value, r, 0);
             set(c, r);
         }
 
+        void add(numeral const & a, numeral const & b, numeral & c) {
+            apply(add_op, a, b, c);
+        }
+
         void sub(numeral const & a, numeral const & b, numeral & c) {
-            value_ref r(*this);
-            sub(a.m_value, b.m_value, r);
-            set(c, r);
+            apply(sub_op, a, b, c);
         }
 
         void mul(numeral const & a, numeral const & b, numeral & c) {
-            value_ref r(*this);
-            mul(a.m_value, b.m_value, r);
-            set(c, r);
+            apply(mul_op, a, b, c);
         }
 
         void div(numeral const & a, numeral const & b, numeral & c) {
-            value_ref r(*this);
-            div(a.m_value, b.m_value, r);
-            set(c, r);
+            apply(div_op, a, b, c);
         }
 
         /**
@@ -5696,21 +5779,37 @@ namespace realclosure {
                     return qm().lt(to_mpq(a), to_mpq(b)) ? -1 : 1;
             }
             else {
-                // FUTURE: try to refine interval before switching to sub+sign approach
                 if (bqim().before(interval(a), interval(b)))
                     return -1;
                 else if (bqim().before(interval(b), interval(a)))
                     return 1;
-                else {
-                    value_ref diff(*this);
-                    sub(a, b, diff);
-                    return sign(diff);
+                // Refine the intervals up to m_max_precision before switching to the sub+sign approach.
+                // Refinements at this precision are kept, so later comparisons start from them.
+                if (!depends_on_infinitesimals(a) && !depends_on_infinitesimals(b)) {
+                    for (unsigned prec = std::max(m_ini_precision, 1u); prec <= m_max_precision; prec *= 2) {
+                        if (!refine_interval(a, prec) || !refine_interval(b, prec))
+                            break;
+                        if (bqim().before(interval(a), interval(b)))
+                            return -1;
+                        else if (bqim().before(interval(b), interval(a)))
+                            return 1;
+                    }
                 }
+                value_ref diff(*this);
+                sub(a, b, diff);
+                return sign(diff);
             }
         }
 
         int compare(numeral const & a, numeral const & b) {
-            return compare(a.m_value, b.m_value);
+            cache_entry * e = get_slot(compare_op, a.m_value, b.m_value);
+            if (is_hit(e, compare_op, a.m_value, b.m_value)) {
+                m_num_cache_hits++;
+                return e->m_cmp;
+            }
+            int r = compare(a.m_value, b.m_value);
+            set_entry(e, compare_op, a.m_value, b.m_value, nullptr, r);
+            return r;
         }
 
         // ---------------------------------
@@ -6045,6 +6144,10 @@ namespace realclosure {
         m_imp->updt_params(p);
     }
 
+    void manager::collect_statistics(statistics & st) const {
+        st.update("rcf cache hits", m_imp->m_num_cache_hits);
+    }
+
     unsynch_mpq_manager & manager::qm() const {
         return m_imp->m_qm;
     }
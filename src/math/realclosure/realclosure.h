@@ -28,6 +28,7 @@ Notes:
 #include "math/interval/interval.h"
 #include "util/z3_exception.h"
 #include "util/rlimit.h"
+#include "util/statistics.h"
 
 namespace realclosure {
     class num;
@@ -60,6 +61,8 @@ namespace realclosure {
 
         void updt_params(params_ref const & p);
 
+        void collect_statistics(statistics & st) const;
+
         unsynch_mpq_manager & qm() const;
 
         void del(numeral & a);
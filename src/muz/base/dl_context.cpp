@@ -285,6 +285,7 @@ namespace datalog {
     unsigned context::dl_profile_milliseconds_threshold() const { return m_params->datalog_profile_timeout_milliseconds(); }
     bool context::all_or_nothing_deltas() const { return m_params->datalog_all_or_nothing_deltas(); }
     bool context::compile_with_widening() const { return m_params->datalog_compile_with_widening(); }
+    bool context::incremental() const { return m_params->datalog_incremental(); }
     bool context::unbound_compressor() const { return m_unbound_compressor; }
     void context::set_unbound_compressor(bool f) { m_unbound_compressor = f; }
     unsigned context::soft_timeout() const { return m_params->datalog_timeout(); }
@@ -1015,12 +1016,40 @@ namespace datalog {
         if (m_engine) {
             m_engine->reset_statistics();
         }
+        m_transform_stats.reset();
+    }
+
+    void context::record_transform(symbol const& name, double sec, unsigned rules_in, unsigned rules_out, double mem) {
+        transform_stats* ts = nullptr;
+        for (transform_stats& t : m_transform_stats) 
+            if (t.m_name == name) 
+                ts = &t;
+        if (!ts) {
+            m_transform_stats.push_back(transform_stats());
+            ts = &m_transform_stats.back();
+            ts->m_name = name;
+            ts->m_mem = mem;
+        }
+        ts->m_runs++;
+        ts->m_time += sec;
+        ts->m_rules_in = rules_in;
+        ts->m_rules_out = rules_out;
+        ts->m_mem = std::max(ts->m_mem, mem);
     }
 
     void context::collect_statistics(statistics& st) const {
         if (m_engine) {
             m_engine->collect_statistics(st);
         }
+        // the keys have to outlive the context, so they are interned as symbols
+        for (transform_stats const& t : m_transform_stats) {
+            std::string name = "xform " + t.m_name.str();
+            st.update(symbol((name + " runs").c_str()).bare_str(), t.m_runs);
+            st.update(symbol((name + " time").c_str()).bare_str(), t.m_time);
+            st.update(symbol((name + " last rules in").c_str()).bare_str(), t.m_rules_in);
+            st.update(symbol((name + " last rules out").c_str()).bare_str(), t.m_rules_out);
+            st.update(symbol((name + " max memory growth (MB)").c_str()).bare_str(), t.m_mem);
+        }
         get_memory_statistics(st);
         get_rlimit_statistics(m.limit(), st);
     }
@@ -193,6 +193,23 @@ namespace datalog {
         expr_ref_vector    m_background;
         model_converter_ref m_mc;
         proof_converter_ref m_pc;
+        /**
+           \brief Cost of a rule transformer, over all of its runs since the
+           statistics were reset:
+           - m_time is the total time,
+           - m_rules_in and m_rules_out are the rule counts of the last run,
+           - m_mem is the largest net change of the allocated memory in a run.
+             It is negative when every run released more memory than it allocated.
+        */
+        struct transform_stats {
+            symbol   m_name;
+            unsigned m_runs = 0;
+            double   m_time = 0;
+            unsigned m_rules_in = 0;
+            unsigned m_rules_out = 0;
+            double   m_mem = 0;
+        };
+        vector<transform_stats> m_transform_stats;
 
         rel_context_base*               m_rel;
         scoped_ptr<engine_base>         m_engine;
@@ -232,6 +249,7 @@ namespace datalog {
         rule_manager & get_rule_manager() { return m_rule_manager; }
         smt_params & get_fparams() const { return m_fparams; }
         fp_params const&  get_params() const { return *m_params; }
+        params_ref const& get_params_ref() const { return m_params_ref; }
         DL_ENGINE get_engine(expr* e = nullptr) { configure_engine(e); return m_engine_type; }
         register_engine_base& get_register_engine() { return m_register_engine; }
         th_rewriter& get_rewriter() { return m_rewriter; }
@@ -253,6 +271,7 @@ namespace datalog {
         unsigned dl_profile_milliseconds_threshold() const;
         bool all_or_nothing_deltas() const;
         bool compile_with_widening() const;
+        bool incremental() const;
         bool unbound_compressor() const;
         void set_unbound_compressor(bool f);
         bool similarity_compressor() const;
@@ -470,6 +489,7 @@ namespace datalog {
 
         void transform_rules(rule_transformer& transf);
         void transform_rules(rule_transformer::plugin* plugin);
+        void record_transform(symbol const& name, double sec, unsigned rules_in, unsigned rules_out, double mem);
         void replace_rules(rule_set const& rs);
         void record_transformed_rules();
 
@@ -19,6 +19,7 @@ Revision History:
 
 #include <algorithm>
 #include<typeinfo>
+#include<cstring>
 
 #include "muz/base/dl_context.h"
 #include "muz/base/dl_rule_transformer.h"
@@ -66,6 +67,31 @@ namespace datalog {
         m_dirty = true;
     }
 
+    /**
+       \brief Return the unqualified class name of a plugin for verbose output
+       and statistics. Names mangled by the Itanium ABI, such as
+       N8datalog13mk_coi_filterE, are reduced to their last component.
+    */
+    static std::string plugin_name(rule_transformer::plugin const& p) {
+        std::string name = typeid(p).name();
+        char const* s = name.c_str();
+        std::string last;
+        if (*s == 'N') ++s;
+        while ('0' <= *s && *s <= '9') {
+            unsigned len = 0;
+            while ('0' <= *s && *s <= '9') 
+                len = 10 * len + (*s++ - '0');
+            if (len > strlen(s))
+                return name;
+            last = std::string(s, len);
+            s += len;
+        }
+        if (!last.empty())
+            return last;
+        size_t pos = name.rfind(':');
+        return pos == std::string::npos ? name : name.substr(pos + 1);
+    }
+
     bool rule_transformer::operator()(rule_set & rules) {
         ensure_ordered();
 
@@ -75,19 +101,29 @@ namespace datalog {
             tout<<"init:\n";
             rules.display(tout);
         );
-        scoped_ptr<rule_set> new_rules = alloc(rule_set, rules);      
+        // The first plugin that changes the rules reads them from the
+        // argument; the rule set is only copied when a transformation
+        // produces a new one, and each intermediate set is released as
+        // soon as the next plugin has produced its successor.
+        scoped_ptr<rule_set> new_rules;
         plugin_vector::iterator it = m_plugins.begin();
         plugin_vector::iterator end = m_plugins.end();
         for(; it!=end && !m_context.canceled(); ++it) {
             plugin & p = **it;
+            rule_set const& src = new_rules ? *new_rules : rules;
+            std::string name = plugin_name(p);
 
-
-            IF_VERBOSE(1, verbose_stream() << "(transform " << typeid(p).name() << "...";);
+            IF_VERBOSE(1, verbose_stream() << "(transform " << name << "...";);
+            unsigned rules_in = src.get_num_rules();
+            double mem_before = static_cast<double>(memory::get_allocation_size());
             stopwatch sw;
             sw.start();
-            scoped_ptr<rule_set> new_rules1 = p(*new_rules);
+            scoped_ptr<rule_set> new_rules1 = p(src);
             sw.stop();
             double sec = sw.get_seconds();
+            double mem = (static_cast<double>(memory::get_allocation_size()) - mem_before) / static_cast<double>(1024*1024);
+            m_context.record_transform(symbol(name.c_str()), sec, rules_in, 
+                                       new_rules1 ? new_rules1->get_num_rules() : rules_in, mem);
             if (sec < 0.001) sec = 0.0;
             if (!new_rules1) {
                 IF_VERBOSE(1, verbose_stream() << "no-op " << sec << "s)\n";);
@@ -108,7 +144,7 @@ namespace datalog {
 
             IF_VERBOSE(1, verbose_stream() << new_rules->get_num_rules() << " rules " << sec << "s)\n";);
             TRACE("dl_rule_transf", 
-                tout << typeid(p).name()<<":\n";
+                tout << name << ":\n";
                 new_rules->display(tout);
             );
         }
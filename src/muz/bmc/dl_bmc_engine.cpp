@@ -35,6 +35,12 @@ Revision History:
 #include "muz/transforms/dl_transforms.h"
 #include "muz/transforms/dl_mk_rule_inliner.h"
 #include "muz/base/fp_params.hpp"
+#include "ast/ast_translation.h"
+#include "util/scoped_ptr_vector.h"
+#include "util/mutex.h"
+#ifndef SINGLE_THREAD
+#include <thread>
+#endif
 
 
 namespace datalog {
@@ -1165,6 +1171,13 @@ namespace datalog {
         lbool check() {
             setup();
             unsigned max_depth = b.m_ctx.get_params().bmc_linear_unrolling_depth();
+#ifndef SINGLE_THREAD
+            unsigned num_threads = b.m_ctx.get_params().bmc_threads();
+            num_threads = std::min((unsigned)std::thread::hardware_concurrency(), num_threads);
+            if (num_threads > 1) {
+                return check_parallel(num_threads, max_depth);
+            }
+#endif
             for (unsigned i = 0; i < max_depth; ++i) {
                 IF_VERBOSE(1, verbose_stream() << "level: " << i << "\n";);
                 b.checkpoint();
@@ -1174,7 +1187,9 @@ namespace datalog {
                     return res;
                 }
                 if (res == l_true) {
-                    get_model(i);
+                    model_ref md;
+                    b.m_solver->get_model(md);
+                    get_model(i, md);
                     return res;
                 }
             }
@@ -1183,16 +1198,114 @@ namespace datalog {
 
     private:
 
-        void get_model(unsigned level) {
+#ifndef SINGLE_THREAD
+        /**
+           Check the depths lvl, lvl + 1, ..., lvl + num_threads - 1 at the
+           same time, each on a solver over a manager of its own. The
+           solvers persist across rounds: a round only adds the formulas
+           of the levels compiled since the previous one, so each solver
+           keeps what it learned on the shared prefix. A counterexample
+           cancels the checks of the deeper levels; the shallowest one
+           is reported.
+        */
+        lbool check_parallel(unsigned num_threads, unsigned max_depth) {
+            if (m.has_trace_stream())
+                throw default_exception("trace streams have to be off in parallel mode");
+            scoped_ptr_vector<ast_manager> pms;
+            sref_vector<solver> psolvers;
+            unsigned_vector num_asserted;
+            scoped_limits sl(m.limit());
+            for (unsigned j = 0; j < num_threads; ++j) {
+                ast_manager* pm = alloc(ast_manager, m, true);
+                pms.push_back(pm);
+                psolvers.push_back(b.m_solver->translate(*pm, solver_params()));
+                num_asserted.push_back(0);
+                sl.push_child(&pm->limit());
+            }
+            vector<lbool> results;
+            std::string ex_msg;
+            mutex mux;
+            for (unsigned lvl = 0; lvl < max_depth; lvl += num_threads) {
+                b.checkpoint();
+                unsigned num_levels = std::min(num_threads, max_depth - lvl);
+                for (unsigned j = 0; j < num_levels; ++j) {
+                    compile(lvl + j);
+                }
+                IF_VERBOSE(1, verbose_stream() << "levels: " << lvl << " - " << (lvl + num_levels - 1) << "\n";);
+                unsigned sz = b.m_solver->get_num_assertions();
+                vector<expr_ref> pqueries;
+                for (unsigned j = 0; j < num_levels; ++j) {
+                    ast_translation tr(m, *pms[j]);
+                    for (unsigned k = num_asserted[j]; k < sz; ++k) {
+                        psolvers[j]->assert_expr(tr(b.m_solver->get_assertion(k)));
+                    }
+                    num_asserted[j] = sz;
+                    pqueries.push_back(expr_ref(tr(mk_level_predicate(b.m_query_pred, lvl + j).get()), *pms[j]));
+                }
+                results.reset();
+                results.resize(num_levels, l_undef);
+                vector<std::thread> threads(num_levels);
+                for (unsigned j = 0; j < num_levels; ++j) {
+                    threads[j] = std::thread([&, j]() {
+                        try {
+                            expr* q = pqueries[j];
+                            results[j] = psolvers[j]->check_sat(1, &q);
+                            if (results[j] == l_true) {
+                                for (unsigned k = j + 1; k < num_levels; ++k) {
+                                    pms[k]->limit().cancel();
+                                }
+                            }
+                        }
+                        catch (z3_exception& ex) {
+                            results[j] = l_undef;
+                            lock_guard lock(mux);
+                            if (ex_msg.empty()) ex_msg = ex.msg();
+                        }
+                    });
+                }
+                for (auto& th : threads) {
+                    th.join();
+                }
+                for (unsigned j = 0; j < num_levels; ++j) {
+                    if (results[j] == l_false) {
+                        continue;
+                    }
+                    if (results[j] == l_undef) {
+                        if (!ex_msg.empty()) {
+                            throw default_exception(std::move(ex_msg));
+                        }
+                        return l_undef;
+                    }
+                    model_ref pmd;
+                    psolvers[j]->get_model(pmd);
+                    ast_translation tr(*pms[j], m);
+                    model_ref md = pmd->translate(tr);
+                    get_model(lvl + j, md);
+                    return l_true;
+                }
+                for (ast_manager* pm : pms) {
+                    pm->limit().reset_cancel();
+                }
+            }
+            return l_undef;
+        }
+#endif
+
+        params_ref solver_params() {
+            params_ref p;
+            p.set_uint("smt.relevancy", 0ul);
+            p.set_bool("smt.mbqi", false);
+            return p;
+        }
+
+        void get_model(unsigned level, model_ref& md) {
             if (!m.inc()) {
                 return;
             }
             rule_manager& rm = b.m_ctx.get_rule_manager();
             expr_ref level_query = mk_level_predicate(b.m_query_pred, level);
-            model_ref md;
             proof_ref pr(m);
             rule_unifier unifier(b.m_ctx);
-            b.m_solver->get_model(md);
             func_decl* pred = b.m_query_pred;
             SASSERT(m.is_true(md->get_const_interp(to_app(level_query)->get_decl())));
 
@@ -1292,10 +1405,7 @@ namespace datalog {
 
 
         void setup() {
-            params_ref p;
-            p.set_uint("smt.relevancy", 0ul);
-            p.set_bool("smt.mbqi", false);
-            b.m_solver->updt_params(p);
+            b.m_solver->updt_params(solver_params());
             b.m_rule_trace.reset();
         }
 
@@ -1099,7 +1099,8 @@ namespace datalog {
 
     void compiler::compile_loop(const func_decl_vector & head_preds, const func_decl_set & widened_preds,
             const pred2idx & global_head_deltas, const pred2idx & global_tail_deltas, 
-            const pred2idx & local_deltas, instruction_block & acc) {
+            const pred2idx & local_deltas, instruction_block & acc,
+            const pred2idx * accumulated_deltas) {
         instruction_block * loop_body = alloc(instruction_block);
         loop_body->set_observer(&m_instruction_observer);
 
@@ -1113,6 +1114,13 @@ namespace datalog {
         //deltas generated earlier in the same iteration.
         compile_preds(head_preds, widened_preds, &all_tail_deltas, all_head_deltas, *loop_body);
 
+        if (accumulated_deltas) {
+            for (auto const& kv : global_head_deltas) {
+                make_union(kv.m_value, accumulated_deltas->find(kv.m_key), execution_context::void_register, 
+                    false, *loop_body);
+            }
+        }
+
         svector<reg_idx> loop_control_regs; //loop is controlled by global src regs
         collect_map_range(loop_control_regs, global_tail_deltas);
         //move target deltas into source deltas at the end of the loop
@@ -1254,6 +1262,104 @@ namespace datalog {
         return true;
     }
 
+    void compiler::compile_incremental_dependent_rules(const func_decl_set & head_preds,
+            pred2idx & deltas, instruction_block & acc) {
+        func_decl_vector preds_vector;
+        func_decl_set global_deltas_dummy;
+        detect_chains(head_preds, preds_vector, global_deltas_dummy);
+
+        pred2idx d_src, d_tgt, d_local, d_acc;
+        get_fresh_registers(head_preds, d_src);
+        get_fresh_registers(head_preds, d_tgt);
+        get_fresh_registers(head_preds, d_acc);
+
+        pred2idx lower_deltas;
+        for (auto const& kv : deltas) {
+            if (!head_preds.contains(kv.m_key)) {
+                lower_deltas.insert(kv.m_key, kv.m_value);
+            }
+        }
+
+        //facts added to predicates of the stratum are new tuples of the first iteration
+        for (func_decl * pred : preds_vector) {
+            reg_idx d;
+            if (deltas.find(pred, d)) {
+                acc.push_back(instruction::mk_clone(d, d_src.find(pred)));
+            }
+        }
+        //so are the tuples derived from the new tuples of lower strata
+        for (func_decl * pred : preds_vector) {
+            for (rule * r : m_rule_set.get_predicate_rules(pred)) {
+                compile_rule_evaluation(r, &lower_deltas, d_src.find(pred), false, acc);
+            }
+        }
+        for (func_decl * pred : preds_vector) {
+            make_union(d_src.find(pred), d_acc.find(pred), execution_context::void_register, false, acc);
+        }
+
+        func_decl_set empty_func_decl_set;
+        compile_loop(preds_vector, empty_func_decl_set, d_tgt, d_src, d_local, acc, &d_acc);
+
+        for (func_decl * pred : preds_vector) {
+            deltas.insert(pred, d_acc.find(pred));
+            acc.push_back(instruction::mk_mark_saturated(m_context.get_manager(), pred));
+        }
+    }
+
+    void compiler::compile_incremental_strats(const rule_stratifier & stratifier, instruction_block & acc) {
+        pred2idx deltas;
+        for (auto const& kv : *m_fact_deltas) {
+            reg_idx reg;
+            if (!m_pred_regs.find(kv.m_key, reg)) {
+                continue;
+            }
+            relation_signature sig = m_reg_signatures[reg];
+            reg_idx d = get_fresh_register(sig);
+            acc.push_back(instruction::mk_load(m_context.get_manager(), kv.m_value, d));
+            deltas.insert(kv.m_key, d);
+        }
+
+        pred2idx empty_pred2idx_map;
+        for (func_decl_set * strat : stratifier.get_strats()) {
+            func_decl_set & strat_preds = *strat;
+            if (all_saturated(strat_preds)) {
+                continue;
+            }
+            bool clean = true;
+            for (func_decl * pred : strat_preds) {
+                clean &= m_clean_preds->contains(pred);
+            }
+            TRACE("dl", tout << (clean ? "incremental" : "full") << " stratum:";
+                  for (func_decl * pred : strat_preds) tout << " " << pred->get_name();
+                  tout << "\n";);
+            if (!clean) {
+                //predicates depending on this stratum are not clean either, so they
+                //do not need its deltas
+                if (is_nonrecursive_stratum(strat_preds)) {
+                    compile_nonrecursive_stratum(strat_preds, nullptr, empty_pred2idx_map, true, acc);
+                }
+                else {
+                    compile_dependent_rules(strat_preds, nullptr, empty_pred2idx_map, true, acc);
+                }
+            }
+            else if (is_nonrecursive_stratum(strat_preds)) {
+                func_decl * head_pred = *strat_preds.begin();
+                reg_idx d;
+                if (!deltas.find(head_pred, d)) {
+                    relation_signature sig = m_reg_signatures[m_pred_regs.find(head_pred)];
+                    d = get_fresh_register(sig);
+                    deltas.insert(head_pred, d);
+                }
+                pred2idx output_deltas;
+                output_deltas.insert(head_pred, d);
+                compile_nonrecursive_stratum(strat_preds, &deltas, output_deltas, true, acc);
+            }
+            else {
+                compile_incremental_dependent_rules(strat_preds, deltas, acc);
+            }
+        }
+    }
+
     void compiler::compile_strats(const rule_stratifier & stratifier, 
             const pred2idx * input_deltas, const pred2idx & output_deltas, 
             bool add_saturation_marks, instruction_block & acc) {
@@ -1315,8 +1421,13 @@ namespace datalog {
         
         pred2idx empty_pred2idx_map;
 
-        compile_strats(m_rule_set.get_stratifier(), static_cast<pred2idx *>(nullptr),
-            empty_pred2idx_map, true, execution_code);
+        if (m_fact_deltas) {
+            compile_incremental_strats(m_rule_set.get_stratifier(), execution_code);
+        }
+        else {
+            compile_strats(m_rule_set.get_stratifier(), static_cast<pred2idx *>(nullptr),
+                empty_pred2idx_map, true, execution_code);
+        }
 
 
 
@@ -118,6 +118,13 @@ namespace datalog {
         obj_map<decl, reg_idx>            m_empty_tables_registers;
         instruction_observer              m_instruction_observer;
         expr_free_vars                    m_free_vars;
+        /**
+           When set, \c m_fact_deltas maps predicates to the predicates whose relations hold
+           the facts added to them since the last saturation, and the relations of the predicates
+           in \c m_clean_preds are saturated with respect to the facts present before.
+        */
+        obj_map<func_decl, func_decl*> const* m_fact_deltas = nullptr;
+        func_decl_set const*                  m_clean_preds = nullptr;
 
 
         /**
@@ -226,9 +233,14 @@ namespace datalog {
 
         void make_inloop_delta_transition(const pred2idx & global_head_deltas, 
             const pred2idx & global_tail_deltas, const pred2idx & local_deltas, instruction_block & acc);
+        /**
+           \brief Generate the saturation loop of a stratum. If \c accumulated_deltas is given,
+           the tuples added in each iteration are also added to these registers.
+        */
         void compile_loop(const func_decl_vector & head_preds, const func_decl_set & widened_preds,
             const pred2idx & global_head_deltas, const pred2idx & global_tail_deltas, 
-            const pred2idx & local_deltas, instruction_block & acc);
+            const pred2idx & local_deltas, instruction_block & acc,
+            const pred2idx * accumulated_deltas = nullptr);
         void compile_dependent_rules(const func_decl_set & head_preds,
             const pred2idx * input_deltas, const pred2idx & output_deltas, 
             bool add_saturation_marks, instruction_block & acc);
@@ -254,6 +266,20 @@ namespace datalog {
 
         bool all_saturated(const func_decl_set & preds) const;
 
+        /**
+           \brief Generate code for a recursive stratum that derives only the consequences of
+           the tuples in \c deltas. The registers holding the new tuples of the stratum are
+           added to \c deltas.
+        */
+        void compile_incremental_dependent_rules(const func_decl_set & head_preds,
+            pred2idx & deltas, instruction_block & acc);
+
+        /**
+           \brief Compile the strata so that the strata of clean predicates are evaluated
+           on the added facts and the tuples derived from them only.
+        */
+        void compile_incremental_strats(const rule_stratifier & stratifier, instruction_block & acc);
+
         void reset();
 
         explicit compiler(context & ctx, rule_set const & rules, instruction_block & top_level_code) 
@@ -278,6 +304,19 @@ namespace datalog {
                 .do_compilation(execution_code, termination_code);
         }
 
+        /**
+           \brief Compile \c rules for relations that are saturated except for the facts added
+           since the last saturation. See \c m_fact_deltas and \c m_clean_preds.
+        */
+        static void compile_incremental(context & ctx, rule_set const & rules,
+                obj_map<func_decl, func_decl*> const & fact_deltas, func_decl_set const & clean_preds,
+                instruction_block & execution_code, instruction_block & termination_code) {
+            compiler c(ctx, rules, execution_code);
+            c.m_fact_deltas = &fact_deltas;
+            c.m_clean_preds = &clean_preds;
+            c.do_compilation(execution_code, termination_code);
+        }
+
     };
 
 
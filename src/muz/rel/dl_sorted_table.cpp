@@ -0,0 +1,481 @@
+/*++
+Copyright (c) 2020 Microsoft Corporation
+
+Module Name:
+
+    dl_sorted_table.cpp
+
+Abstract:
+
+    Table that keeps its rows in a lexicographically sorted array.
+
+Revision History:
+
+--*/
+
+#include <algorithm>
+#include "muz/base/dl_context.h"
+#include "muz/rel/dl_sorted_table.h"
+
+namespace datalog {
+
+    namespace {
+
+        int compare_rows(const table_element * a, const table_element * b, unsigned n) {
+            for (unsigned i = 0; i < n; ++i) {
+                if (a[i] != b[i]) {
+                    return a[i] < b[i] ? -1 : 1;
+                }
+            }
+            return 0;
+        }
+
+        int compare_keys(const table_element * a, const unsigned * cols_a,
+                         const table_element * b, const unsigned * cols_b, unsigned n) {
+            for (unsigned i = 0; i < n; ++i) {
+                table_element va = a[cols_a[i]], vb = b[cols_b[i]];
+                if (va != vb) {
+                    return va < vb ? -1 : 1;
+                }
+            }
+            return 0;
+        }
+
+        /**
+           \brief Return the first position in [lo, hi) where below fails, assuming below
+           holds on a prefix of the range. The search is exponential from lo, so it is
+           cheap when the position is close to lo.
+        */
+        template<typename Below>
+        unsigned gallop(unsigned lo, unsigned hi, Below const & below) {
+            if (lo >= hi || !below(lo)) {
+                return lo;
+            }
+            unsigned step = 1;
+            unsigned last = lo; // below(last) holds
+            while (hi - last > step && below(last + step)) {
+                last += step;
+                step *= 2;
+            }
+            unsigned end = std::min(hi, last + step);
+            // below(last) holds, the answer is in (last, end]
+            while (end - last > 1) {
+                unsigned mid = last + (end - last) / 2;
+                if (below(mid)) {
+                    last = mid;
+                }
+                else {
+                    end = mid;
+                }
+            }
+            return end;
+        }
+    }
+
+    // -----------------------------------
+    //
+    // sorted_table
+    //
+    // -----------------------------------
+
+    void sorted_table::append_pending(const table_element * f) {
+        m_pending.append(m_arity, f);
+        m_pending_size++;
+    }
+
+    void sorted_table::invalidate_indexes() const {
+        m_index_cols.reset();
+        m_index_rows.reset();
+    }
+
+    void sorted_table::normalize() const {
+        if (m_pending_size == 0) {
+            return;
+        }
+        unsigned n = m_arity;
+        if (n == 0) {
+            m_size = 1;
+            m_pending_size = 0;
+            m_pending.reset();
+            invalidate_indexes();
+            return;
+        }
+        unsigned_vector order;
+        for (unsigned i = 0; i < m_pending_size; ++i) {
+            order.push_back(i);
+        }
+        const table_element * pending = m_pending.data();
+        std::sort(order.begin(), order.end(), [&](unsigned a, unsigned b) {
+            return compare_rows(pending + a * n, pending + b * n, n) < 0;
+        });
+        svector<table_element> merged;
+        unsigned i = 0, j = 0, size = 0;
+        while (i < m_size || j < m_pending_size) {
+            const table_element * next;
+            if (j == m_pending_size) {
+                next = row(i++);
+            }
+            else if (i == m_size) {
+                next = pending + order[j++] * n;
+            }
+            else {
+                const table_element * p = pending + order[j] * n;
+                int c = compare_rows(row(i), p, n);
+                if (c <= 0) {
+                    next = row(i++);
+                    if (c == 0) {
+                        ++j;
+                    }
+                }
+                else {
+                    next = p;
+                    ++j;
+                }
+            }
+            // merged may be reallocated by append, so the last row is looked up by position
+            if (size > 0 && compare_rows(merged.data() + (size - 1) * n, next, n) == 0) {
+                continue;
+            }
+            merged.append(n, next);
+            ++size;
+        }
+        m_rows.swap(merged);
+        m_size = size;
+        m_pending.reset();
+        m_pending_size = 0;
+        invalidate_indexes();
+    }
+
+    const unsigned_vector * sorted_table::get_index(unsigned col_cnt, const unsigned * cols) const {
+        normalize();
+        bool is_prefix = true;
+        for (unsigned i = 0; is_prefix && i < col_cnt; ++i) {
+            is_prefix = cols[i] == i;
+        }
+        if (is_prefix) {
+            return nullptr;
+        }
+        unsigned_vector key(col_cnt, cols);
+        for (unsigned i = 0; i < m_index_cols.size(); ++i) {
+            if (m_index_cols[i] == key) {
+                return &m_index_rows[i];
+            }
+        }
+        unsigned_vector order;
+        for (unsigned i = 0; i < m_size; ++i) {
+            order.push_back(i);
+        }
+        std::sort(order.begin(), order.end(), [&](unsigned a, unsigned b) {
+            int c = compare_keys(row(a), cols, row(b), cols, col_cnt);
+            return c < 0 || (c == 0 && a < b);
+        });
+        m_index_cols.push_back(key);
+        m_index_rows.push_back(order);
+        return &m_index_rows.back();
+    }
+
+    bool sorted_table::find_row(const table_element * f, unsigned & idx) const {
+        normalize();
+        idx = gallop(0, m_size, [&](unsigned i) { return compare_rows(row(i), f, m_arity) < 0; });
+        return idx < m_size && compare_rows(row(idx), f, m_arity) == 0;
+    }
+
+    bool sorted_table::contains_fact(const table_fact & f) const {
+        unsigned idx;
+        return find_row(f.data(), idx);
+    }
+
+    void sorted_table::remove_fact(const table_element * fact) {
+        unsigned idx;
+        if (!find_row(fact, idx)) {
+            return;
+        }
+        unsigned n = m_arity;
+        for (unsigned k = (idx + 1) * n; k < m_size * n; ++k) {
+            m_rows[k - n] = m_rows[k];
+        }
+        m_rows.shrink((m_size - 1) * n);
+        m_size--;
+        invalidate_indexes();
+    }
+
+    void sorted_table::remove_facts(unsigned fact_cnt, const table_fact * facts) {
+        svector<table_element> rows;
+        for (unsigned i = 0; i < fact_cnt; ++i) {
+            rows.append(m_arity, facts[i].data());
+        }
+        remove_facts(fact_cnt, rows.data());
+    }
+
+    /**
+       Remove the rows in one pass over the table after sorting the rows to remove.
+       The default implementation removes them one at a time, which is quadratic
+       for this representation.
+    */
+    void sorted_table::remove_facts(unsigned fact_cnt, const table_element * facts) {
+        normalize();
+        if (fact_cnt == 0 || m_size == 0) {
+            return;
+        }
+        unsigned n = m_arity;
+        if (n == 0) {
+            reset();
+            return;
+        }
+        unsigned_vector order;
+        for (unsigned i = 0; i < fact_cnt; ++i) {
+            order.push_back(i);
+        }
+        std::sort(order.begin(), order.end(), [&](unsigned a, unsigned b) {
+            return compare_rows(facts + a * n, facts + b * n, n) < 0;
+        });
+        unsigned i = 0, j = 0, k = 0;
+        for (; i < m_size; ++i) {
+            const table_element * r = row(i);
+            int c = -1;
+            while (j < fact_cnt && (c = compare_rows(facts + order[j] * n, r, n)) < 0) {
+                ++j;
+            }
+            if (j < fact_cnt && c == 0) {
+                continue;
+            }
+            if (i != k) {
+                for (unsigned l = 0; l < n; ++l) {
+                    m_rows[k * n + l] = r[l];
+                }
+            }
+            ++k;
+        }
+        if (k != m_size) {
+            m_rows.shrink(k * n);
+            m_size = k;
+            invalidate_indexes();
+        }
+    }
+
+    void sorted_table::reset() {
+        m_rows.reset();
+        m_pending.reset();
+        m_size = 0;
+        m_pending_size = 0;
+        invalidate_indexes();
+    }
+
+    table_base * sorted_table::clone() const {
+        normalize();
+        sorted_table * res = static_cast<sorted_table *>(get_plugin().mk_empty(get_signature()));
+        res->m_rows = m_rows;
+        res->m_size = m_size;
+        return res;
+    }
+
+    class sorted_table::our_iterator_core : public iterator_core {
+        const sorted_table & m_parent;
+        unsigned m_idx;
+
+        class our_row : public row_interface {
+            const our_iterator_core & m_parent;
+        public:
+            our_row(const our_iterator_core & parent) : row_interface(parent.m_parent), m_parent(parent) {}
+
+            void get_fact(table_fact & result) const override {
+                const sorted_table & t = m_parent.m_parent;
+                result.reset();
+                result.append(t.m_arity, t.row(m_parent.m_idx));
+            }
+            table_element operator[](unsigned col) const override {
+                return m_parent.m_parent.row(m_parent.m_idx)[col];
+            }
+        };
+
+        our_row m_row_obj;
+
+    public:
+        our_iterator_core(const sorted_table & t, bool finished) :
+            m_parent(t), m_idx(finished ? t.m_size : 0), m_row_obj(*this) {}
+
+        bool is_finished() const override {
+            return m_idx == m_parent.m_size;
+        }
+
+        row_interface & operator*() override {
+            SASSERT(!is_finished());
+            return m_row_obj;
+        }
+        void operator++() override {
+            SASSERT(!is_finished());
+            ++m_idx;
+        }
+    };
+
+    table_base::iterator sorted_table::begin() const {
+        normalize();
+        return mk_iterator(alloc(our_iterator_core, *this, false));
+    }
+
+    table_base::iterator sorted_table::end() const {
+        normalize();
+        return mk_iterator(alloc(our_iterator_core, *this, true));
+    }
+
+    // -----------------------------------
+    //
+    // sorted_table_plugin
+    //
+    // -----------------------------------
+
+    bool sorted_table_plugin::can_handle_signature(const table_signature & s) {
+        return s.functional_columns() == 0;
+    }
+
+    table_base * sorted_table_plugin::mk_empty(const table_signature & s) {
+        SASSERT(can_handle_signature(s));
+        return alloc(sorted_table, *this, s);
+    }
+
+    /**
+       Leapfrog join on the joined columns. The table whose current key is smaller
+       seeks to the first row with a key that is not smaller than the key of the
+       other table. When the keys agree, the runs of rows with that key are joined.
+       Since neither table has duplicate rows, the result has no duplicate rows
+       unless columns are removed, in which case it is normalized when it is read.
+    */
+    class sorted_table_plugin::join_project_fn : public convenient_table_join_project_fn {
+        bool_vector m_keep;
+    public:
+        join_project_fn(const table_signature & t1_sig, const table_signature & t2_sig, unsigned col_cnt,
+                const unsigned * cols1, const unsigned * cols2, unsigned removed_col_cnt,
+                const unsigned * removed_cols)
+                : convenient_table_join_project_fn(t1_sig, t2_sig, col_cnt, cols1, cols2,
+                removed_col_cnt, removed_cols) {
+            m_keep.resize(t1_sig.size() + t2_sig.size(), true);
+            for (unsigned i = 0; i < removed_col_cnt; ++i) {
+                m_keep[removed_cols[i]] = false;
+            }
+        }
+
+        table_base * operator()(const table_base & tb1, const table_base & tb2) override {
+            const sorted_table & t1 = static_cast<const sorted_table &>(tb1);
+            const sorted_table & t2 = static_cast<const sorted_table &>(tb2);
+            sorted_table * res = static_cast<sorted_table *>(t1.get_plugin().mk_empty(get_result_signature()));
+
+            unsigned k = m_cols1.size();
+            const unsigned * cols1 = m_cols1.data();
+            const unsigned * cols2 = m_cols2.data();
+            t1.get_index(k, cols1);
+            const unsigned_vector * order2 = t2.get_index(k, cols2);
+            // t1 may be t2, so order1 is only looked up after all indexes were created
+            const unsigned_vector * order1 = t1.get_index(k, cols1);
+            auto row1 = [&](unsigned i) { return t1.row(order1 ? (*order1)[i] : i); };
+            auto row2 = [&](unsigned i) { return t2.row(order2 ? (*order2)[i] : i); };
+            unsigned n1 = t1.m_size, n2 = t2.m_size;
+
+            svector<table_element> acc;
+            auto emit = [&](const table_element * r1, const table_element * r2) {
+                acc.reset();
+                for (unsigned c = 0; c < t1.m_arity; ++c) {
+                    if (m_keep[c]) {
+                        acc.push_back(r1[c]);
+                    }
+                }
+                for (unsigned c = 0; c < t2.m_arity; ++c) {
+                    if (m_keep[t1.m_arity + c]) {
+                        acc.push_back(r2[c]);
+                    }
+                }
+                res->append_pending(acc.data());
+            };
+
+            unsigned i = 0, j = 0;
+            while (i < n1 && j < n2) {
+                const table_element * r1 = row1(i);
+                const table_element * r2 = row2(j);
+                int c = compare_keys(r1, cols1, r2, cols2, k);
+                if (c < 0) {
+                    i = gallop(i, n1, [&](unsigned p) { return compare_keys(row1(p), cols1, r2, cols2, k) < 0; });
+                }
+                else if (c > 0) {
+                    j = gallop(j, n2, [&](unsigned p) { return compare_keys(r1, cols1, row2(p), cols2, k) > 0; });
+                }
+                else {
+                    unsigned i_end = gallop(i, n1, [&](unsigned p) { return compare_keys(row1(p), cols1, r2, cols2, k) == 0; });
+                    unsigned j_end = gallop(j, n2, [&](unsigned p) { return compare_keys(r1, cols1, row2(p), cols2, k) == 0; });
+                    for (unsigned a = i; a < i_end; ++a) {
+                        for (unsigned b = j; b < j_end; ++b) {
+                            emit(row1(a), row2(b));
+                        }
+                    }
+                    i = i_end;
+                    j = j_end;
+                }
+            }
+            return res;
+        }
+    };
+
+    table_join_fn * sorted_table_plugin::mk_join_fn(const table_base & t1, const table_base & t2,
+            unsigned col_cnt, const unsigned * cols1, const unsigned * cols2) {
+        return mk_join_project_fn(t1, t2, col_cnt, cols1, cols2, 0, nullptr);
+    }
+
+    table_join_fn * sorted_table_plugin::mk_join_project_fn(const table_base & t1, const table_base & t2,
+            unsigned col_cnt, const unsigned * cols1, const unsigned * cols2, unsigned removed_col_cnt,
+            const unsigned * removed_cols) {
+        if (t1.get_kind() != get_kind() || t2.get_kind() != get_kind()) {
+            return nullptr;
+        }
+        return alloc(join_project_fn, t1.get_signature(), t2.get_signature(), col_cnt, cols1, cols2,
+            removed_col_cnt, removed_cols);
+    }
+
+    /**
+       Merge the sorted rows of src into tgt. The rows of src that are not in tgt
+       are the delta.
+    */
+    class sorted_table_plugin::union_fn : public table_union_fn {
+        table_fact m_row;
+    public:
+        void operator()(table_base & tb, const table_base & sb, table_base * delta) override {
+            sorted_table & tgt = static_cast<sorted_table &>(tb);
+            const sorted_table & src = static_cast<const sorted_table &>(sb);
+            if (&tgt == &src) {
+                return;
+            }
+            src.normalize();
+            if (!delta) {
+                tgt.m_pending.append(src.m_rows);
+                tgt.m_pending_size += src.m_size;
+                return;
+            }
+            tgt.normalize();
+            sorted_table * sdelta = delta->get_kind() == tgt.get_kind() ? static_cast<sorted_table *>(delta) : nullptr;
+            unsigned n = tgt.m_arity;
+            unsigned i = 0;
+            for (unsigned j = 0; j < src.m_size; ++j) {
+                const table_element * r = src.row(j);
+                i = gallop(i, tgt.m_size, [&](unsigned p) { return compare_rows(tgt.row(p), r, n) < 0; });
+                if (i < tgt.m_size && compare_rows(tgt.row(i), r, n) == 0) {
+                    continue;
+                }
+                tgt.append_pending(r);
+                if (sdelta) {
+                    sdelta->append_pending(r);
+                }
+                else {
+                    m_row.reset();
+                    m_row.append(n, r);
+                    delta->add_fact(m_row);
+                }
+            }
+        }
+    };
+
+    table_union_fn * sorted_table_plugin::mk_union_fn(const table_base & tgt, const table_base & src,
+            const table_base * delta) {
+        if (tgt.get_kind() != get_kind() || src.get_kind() != get_kind()) {
+            return nullptr;
+        }
+        return alloc(union_fn);
+    }
+
+};
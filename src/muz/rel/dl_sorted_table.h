@@ -0,0 +1,118 @@
+/*++
+Copyright (c) 2020 Microsoft Corporation
+
+Module Name:
+
+    dl_sorted_table.h
+
+Abstract:
+
+    Table that keeps its rows in a lexicographically sorted array.
+
+    The rows are stored row after row in a single array of table
+    elements, without duplicates. Added rows are collected in
+    a pending array that is sorted and merged into the rows when the
+    table is read next.
+
+    Joins are leapfrog joins: both tables are traversed in the order
+    of the joined columns and the traversal that is behind seeks to
+    the key of the other one by exponential search. Orders of the
+    rows other than the lexicographic one are kept as permutations
+    that are computed on demand and dropped when the table changes.
+
+Revision History:
+
+--*/
+#pragma once
+
+#include "util/vector.h"
+#include "muz/rel/dl_base.h"
+
+namespace datalog {
+
+    class sorted_table;
+
+    class sorted_table_plugin : public table_plugin {
+        friend class sorted_table;
+    protected:
+        class join_project_fn;
+        class union_fn;
+    public:
+        typedef sorted_table table;
+
+        sorted_table_plugin(relation_manager & manager)
+            : table_plugin(symbol("sorted"), manager) {}
+
+        bool can_handle_signature(const table_signature & s) override;
+
+        table_base * mk_empty(const table_signature & s) override;
+
+        table_join_fn * mk_join_fn(const table_base & t1, const table_base & t2,
+            unsigned col_cnt, const unsigned * cols1, const unsigned * cols2) override;
+        table_join_fn * mk_join_project_fn(const table_base & t1, const table_base & t2,
+            unsigned col_cnt, const unsigned * cols1, const unsigned * cols2, unsigned removed_col_cnt,
+            const unsigned * removed_cols) override;
+        table_union_fn * mk_union_fn(const table_base & tgt, const table_base & src,
+            const table_base * delta) override;
+    };
+
+    class sorted_table : public table_base {
+        friend class sorted_table_plugin;
+        friend class sorted_table_plugin::join_project_fn;
+        friend class sorted_table_plugin::union_fn;
+
+        class our_iterator_core;
+
+        unsigned                          m_arity;
+        mutable unsigned                  m_size = 0;          // number of rows in m_rows
+        mutable svector<table_element>    m_rows;              // sorted, without duplicates
+        mutable unsigned                  m_pending_size = 0;  // number of rows in m_pending
+        mutable svector<table_element>    m_pending;
+        mutable vector<unsigned_vector>   m_index_cols;        // columns of the cached orders
+        mutable vector<unsigned_vector>   m_index_rows;        // rows sorted by m_index_cols[i]
+
+        sorted_table(sorted_table_plugin & plugin, const table_signature & sig)
+            : table_base(plugin, sig), m_arity(sig.size()) {}
+
+        const table_element * row(unsigned i) const { return m_rows.data() + i * m_arity; }
+        void append_pending(const table_element * f);
+        void invalidate_indexes() const;
+        /**
+           \brief Sort the pending rows and merge them into the sorted rows.
+        */
+        void normalize() const;
+        /**
+           \brief Return the rows sorted by the columns in cols, or nullptr if the lexicographic
+           order of the rows already is such an order.
+        */
+        const unsigned_vector * get_index(unsigned col_cnt, const unsigned * cols) const;
+        bool find_row(const table_element * f, unsigned & idx) const;
+    public:
+        sorted_table_plugin & get_plugin() const
+        { return static_cast<sorted_table_plugin &>(table_base::get_plugin()); }
+
+        table_base * clone() const override;
+        bool empty() const override { return m_size == 0 && m_pending_size == 0; }
+        void add_fact(const table_fact & f) override { append_pending(f.data()); }
+        /**
+           \brief Remove one row. The rows behind it are shifted and the cached orders are
+           dropped, so this is linear in the size of the table. Several rows should be
+           removed with remove_facts, which removes them in one pass.
+        */
+        void remove_fact(const table_element * fact) override;
+        void remove_facts(unsigned fact_cnt, const table_fact * facts) override;
+        void remove_facts(unsigned fact_cnt, const table_element * facts) override;
+        bool contains_fact(const table_fact & f) const override;
+        void reset() override;
+
+        iterator begin() const override;
+        iterator end() const override;
+
+        unsigned get_size_estimate_rows() const override { normalize(); return m_size; }
+        unsigned get_size_estimate_bytes() const override {
+            return (m_rows.size() + m_pending.size()) * sizeof(table_element);
+        }
+        bool knows_exact_size() const override { return true; }
+    };
+
+};
@@ -18,7 +18,15 @@ Revision History:
 --*/
 
 #include<utility>
+#include<algorithm>
+#ifndef SINGLE_THREAD
+#include<atomic>
+#include<thread>
+#include<mutex>
+#include<exception>
+#endif
 #include "muz/base/dl_context.h"
+#include "muz/base/fp_params.hpp"
 #include "muz/base/dl_util.h"
 #include "muz/rel/dl_sparse_table.h"
 
@@ -685,6 +693,11 @@ namespace datalog {
             return;
         }
 
+        if (parallel_join_project(t1, t2, joined_col_cnt, t1_joined_cols, t2_joined_cols,
+                                  removed_cols, tables_swapped, result)) {
+            return;
+        }
+
         key_value t1_key;
         t1_key.resize(joined_col_cnt);
         key_indexer& t2_indexer = t2.get_key_indexer(joined_col_cnt, t2_joined_cols);
@@ -731,6 +744,127 @@ namespace datalog {
         }
     }
 
+    /**
+       The (hash, offset) pairs of the rows of t2 are computed and sorted once, and
+       shared by the workers. The key indexers of t2 are not used since their lookups
+       write into buffers owned by t2. Worker p probes the sorted pairs with the p-th
+       slice of the rows of t1. The joined rows are collected in private buffers that
+       are added to result in the order of the workers once all of them are done, so
+       the content of result does not depend on the scheduling. An exception thrown by
+       a worker is rethrown after all workers are done.
+    */
+    bool sparse_table::parallel_join_project(const sparse_table & t1, const sparse_table & t2,
+            unsigned joined_col_cnt, const unsigned * t1_joined_cols, const unsigned * t2_joined_cols,
+            const unsigned * removed_cols, bool tables_swapped, sparse_table & result) {
+#ifdef SINGLE_THREAD
+        return false;
+#else
+        unsigned num_threads = result.get_plugin().get_context().get_params().datalog_join_threads();
+        unsigned min_rows = result.get_plugin().get_context().get_params().datalog_join_threads_min_rows();
+        if (num_threads <= 1 || joined_col_cnt == 0 || t1.row_count() + t2.row_count() < min_rows) {
+            return false;
+        }
+        typedef std::pair<unsigned, store_offset> hashed_row;
+        unsigned t1_entry_size = t1.m_fact_size;
+        unsigned t2_entry_size = t2.m_fact_size;
+        unsigned res_entry_size = result.m_fact_size;
+        store_offset t2end = t2.m_data.after_last_offset();
+
+        auto key_hash = [&](const sparse_table & t, const unsigned * cols, const char * rec) {
+            unsigned h = 17;
+            for (unsigned i = 0; i < joined_col_cnt; i++) {
+                h = combine_hash(h, hash_ull(t.m_column_layout.get(rec, cols[i])));
+            }
+            return h;
+        };
+        auto same_key = [&](const char * t1ptr, const char * t2ptr) {
+            for (unsigned i = 0; i < joined_col_cnt; i++) {
+                if (t1.m_column_layout.get(t1ptr, t1_joined_cols[i]) != t2.m_column_layout.get(t2ptr, t2_joined_cols[i])) {
+                    return false;
+                }
+            }
+            return true;
+        };
+
+        svector<hashed_row> t2_rows;
+        for (store_offset t2idx = 0; t2idx < t2end; t2idx += t2_entry_size) {
+            t2_rows.push_back(hashed_row(key_hash(t2, t2_joined_cols, t2.get_at_offset(t2idx)), t2idx));
+        }
+        std::sort(t2_rows.begin(), t2_rows.end());
+
+        size_t t1_rows = t1.row_count();
+        size_t slice = (t1_rows + num_threads - 1) / num_threads;
+        vector<svector<char>> buffers(num_threads);
+        std::atomic<bool> failed(false);
+        std::atomic<bool> out_of_memory(false);
+        std::exception_ptr ex;
+        std::mutex ex_mux;
+        auto worker = [&](unsigned p) {
+            try {
+                // column writes may touch up to sizeof(uint64_t) bytes past the end of a row
+                svector<char> row(res_entry_size + sizeof(uint64_t), (char)0);
+                svector<char> & buffer = buffers[p];
+                store_offset t1begin = std::min(t1_rows, p * slice) * t1_entry_size;
+                store_offset t1end = std::min(t1_rows, (p + 1) * slice) * t1_entry_size;
+                for (store_offset t1idx = t1begin; t1idx < t1end && !failed; t1idx += t1_entry_size) {
+                    const char * t1ptr = t1.get_at_offset(t1idx);
+                    unsigned h = key_hash(t1, t1_joined_cols, t1ptr);
+                    auto it = std::lower_bound(t2_rows.begin(), t2_rows.end(), hashed_row(h, 0));
+                    for (; it != t2_rows.end() && it->first == h; ++it) {
+                        const char * t2ptr = t2.get_at_offset(it->second);
+                        if (!same_key(t1ptr, t2ptr)) {
+                            continue;
+                        }
+                        memset(row.data(), 0, row.size());
+                        if (tables_swapped) {
+                            concatenate_rows(t2.m_column_layout, t1.m_column_layout, result.m_column_layout,
+                                t2ptr, t1ptr, row.data(), removed_cols);
+                        } else {
+                            concatenate_rows(t1.m_column_layout, t2.m_column_layout, result.m_column_layout,
+                                t1ptr, t2ptr, row.data(), removed_cols);
+                        }
+                        buffer.append(res_entry_size, row.data());
+                    }
+                    if (memory::above_high_watermark()) {
+                        out_of_memory = true;
+                        failed = true;
+                    }
+                }
+            }
+            catch (...) {
+                std::lock_guard<std::mutex> lock(ex_mux);
+                if (!ex) {
+                    ex = std::current_exception();
+                }
+                failed = true;
+            }
+        };
+
+        vector<std::thread> threads(num_threads);
+        for (unsigned i = 0; i < num_threads; ++i) {
+            threads[i] = std::thread([&, i]() { worker(i); });
+        }
+        for (auto & th : threads) {
+            th.join();
+        }
+        if (ex) {
+            std::rethrow_exception(ex);
+        }
+        if (out_of_memory) {
+            IF_VERBOSE(1, verbose_stream() << "Ran out of memory while joining tables of size: " << t1.row_count() << " and " << t2.row_count() << " rows\n";);
+            throw out_of_memory_error();
+        }
+        for (svector<char> const & buffer : buffers) {
+            for (unsigned ofs = 0; ofs < buffer.size(); ofs += res_entry_size) {
+                result.m_data.write_into_reserve(buffer.data() + ofs);
+                result.garbage_collect();
+                result.add_reserve_content();
+            }
+        }
+        return true;
+#endif
+    }
+
 
     // -----------------------------------
     //
@@ -452,6 +452,15 @@ namespace datalog {
             unsigned joined_col_cnt, const unsigned * t1_joined_cols, const unsigned * t2_joined_cols,
             const unsigned * removed_cols, bool tables_swapped, sparse_table & result);
 
+        /**
+           \brief Parallel version of \c self_agnostic_join_project for joins with at least
+           one joined column. The rows of t1 are split among the threads.
+           Return false if the join should be done sequentially.
+        */
+        static bool parallel_join_project(const sparse_table & t1, const sparse_table & t2,
+            unsigned joined_col_cnt, const unsigned * t1_joined_cols, const unsigned * t2_joined_cols,
+            const unsigned * removed_cols, bool tables_swapped, sparse_table & result);
+
 
         /**
            If the fact at \c data (in table's native representation) is not in the table,
@@ -9,6 +9,128 @@ Copyright (c) 2015 Microsoft Corporation
 #include "ast/ast_util.h"
 
 namespace datalog {
+
+    /**
+       \brief Rational rows in reduced row echelon form.
+
+       Rows are added one at a time: a new row is reduced by the rows
+       present, and what remains, if anything, becomes a row of its own
+       whose pivot column is eliminated from the other rows. Only the
+       non-zero entries of a row take part in the elimination.
+    */
+    class karr_echelon {
+        unsigned                 m_num_cols;
+        vector<vector<rational>> m_rows;
+        unsigned_vector          m_pivots;   // pivot column of each row, its entry is 1
+
+        // row -= c*r
+        static void sub_mul(vector<rational>& row, rational const& c, vector<rational> const& r) {
+            for (unsigned j = 0; j < r.size(); ++j) {
+                if (!r[j].is_zero()) {
+                    row[j] -= c * r[j];
+                }
+            }
+        }
+
+        static void to_int(vector<rational>& v) {
+            rational d(1), g(0);
+            for (rational const& c : v) {
+                if (!c.is_zero()) {
+                    d = lcm(d, denominator(c));
+                }
+            }
+            for (rational& c : v) {
+                c *= d;
+                if (!c.is_zero()) {
+                    g = gcd(g, abs(c));
+                }
+            }
+            if (g > rational(1)) {
+                for (rational& c : v) {
+                    c /= g;
+                }
+            }
+        }
+
+    public:
+        karr_echelon(unsigned num_cols): m_num_cols(num_cols) {}
+
+        unsigned_vector const& pivots() const { return m_pivots; }
+
+        /**
+           \brief Add a row. Return true if it is independent of the rows present.
+        */
+        bool add(vector<rational> row) {
+            SASSERT(row.size() == m_num_cols);
+            for (unsigned i = 0; i < m_rows.size(); ++i) {
+                rational c = row[m_pivots[i]];
+                if (!c.is_zero()) {
+                    sub_mul(row, c, m_rows[i]);
+                }
+            }
+            unsigned p = 0;
+            while (p < m_num_cols && row[p].is_zero()) {
+                ++p;
+            }
+            if (p == m_num_cols) {
+                return false;
+            }
+            rational inv = rational(1) / row[p];
+            for (unsigned j = p; j < m_num_cols; ++j) {
+                row[j] *= inv;
+            }
+            for (vector<rational>& r : m_rows) {
+                rational c = r[p];
+                if (!c.is_zero()) {
+                    sub_mul(r, c, row);
+                }
+            }
+            m_rows.push_back(row);
+            m_pivots.push_back(p);
+            return true;
+        }
+
+        /**
+           \brief Solution of the system sum_j row[j]*x_j + row[num_cols] = 0
+           where the variables that are not pivots are 0. 
+           Requires that no pivot is at column num_cols.
+        */
+        void particular_solution(unsigned num_cols, vector<rational>& x) const {
+            x.reset();
+            x.resize(num_cols);
+            for (unsigned i = 0; i < m_rows.size(); ++i) {
+                SASSERT(m_pivots[i] < num_cols);
+                x[m_pivots[i]] = -m_rows[i][num_cols];
+            }
+        }
+
+        /**
+           \brief Add integer vectors spanning the solutions of the homogeneous
+           system over the first num_cols columns to result.
+           Requires that all pivots are below num_cols.
+        */
+        void null_space(unsigned num_cols, vector<vector<rational>>& result) const {
+            bool_vector is_pivot(m_num_cols, false);
+            for (unsigned p : m_pivots) {
+                SASSERT(p < num_cols);
+                is_pivot[p] = true;
+            }
+            for (unsigned f = 0; f < num_cols; ++f) {
+                if (is_pivot[f]) {
+                    continue;
+                }
+                vector<rational> v;
+                v.resize(num_cols);
+                v[f] = rational(1);
+                for (unsigned i = 0; i < m_rows.size(); ++i) {
+                    v[m_pivots[i]] = -m_rows[i][f];
+                }
+                to_int(v);
+                result.push_back(v);
+            }
+        }
+    };
+
     class karr_relation : public relation_base {              
         friend class karr_relation_plugin;
         friend class karr_relation_plugin::filter_equal_fn;
@@ -309,15 +431,16 @@ namespace datalog {
             }
             matrix& N = get_basis();
             unsigned N_size = N.size();
+            // The basis spans the affine hull with rows (x, 1) for points
+            // and (d, 0) for directions. A row that is a linear combination
+            // of the rows present does not extend the hull and is skipped.
+            unsigned num_cols = get_signature().size();
+            karr_echelon ech(num_cols + 1);
+            for (unsigned j = 0; j < N_size; ++j) {
+                ech.add(homogenize(N, j));
+            }
             for (unsigned i = 0; i < M.size(); ++i) {
-                bool found = false;
-                for (unsigned j = 0; !found && j < N_size; ++j) {
-                    found = 
-                        same_row(M.A[i], N.A[j]) &&
-                        M.b[i] == N.b[j] &&
-                        M.eq[i] == N.eq[j];
-                }
-                if (!found) {
+                if (ech.add(homogenize(M, i))) {
                     N.A.push_back(M.A[i]);
                     N.b.push_back(M.b[i]);
                     N.eq.push_back(M.eq[i]);
@@ -361,14 +484,11 @@ namespace datalog {
             m_empty = other.m_empty;
         }
 
-        bool same_row(vector<rational> const& r1, vector<rational> const& r2) const {
-            SASSERT(r1.size() == r2.size());
-            for (unsigned i = 0; i < r1.size(); ++i) {
-                if (r1[i] != r2[i]) {
-                    return false;
-                }
-            }
-            return true;
+        static vector<rational> homogenize(matrix const& M, unsigned i) {
+            SASSERT(M.eq[i]);
+            vector<rational> row(M.A[i]);
+            row.push_back(M.b[i]);
+            return row;
         }
 
         void mk_rename(matrix& M, unsigned col_cnt, unsigned const* cols) {
@@ -576,8 +696,63 @@ namespace datalog {
         return alloc(rename_fn, *this, r.get_signature(), cycle_len, permutation_cycle);
     }
 
+    static bool all_eqs(matrix const& M) {
+        for (unsigned i = 0; i < M.size(); ++i) {
+            if (!M.eq[i]) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+       \brief The integer solutions of a system of equalities A*x + b = 0 span
+       the same affine space as the rational ones if there is an integer
+       solution. Compute a point and directions of this space by elimination
+       and return l_undef if it does not produce an integer point.
+    */
+    static lbool dualize_eqs(matrix& dst, matrix const& src) {
+        unsigned num_cols = src.A[0].size();
+        karr_echelon ech(num_cols + 1);
+        for (unsigned i = 0; i < src.size(); ++i) {
+            vector<rational> row(src.A[i]);
+            row.push_back(src.b[i]);
+            ech.add(row);
+        }
+        for (unsigned p : ech.pivots()) {
+            if (p == num_cols) {
+                return l_false;
+            }
+        }
+        vector<rational> x;
+        ech.particular_solution(num_cols, x);
+        for (rational const& c : x) {
+            if (!c.is_int()) {
+                return l_undef;
+            }
+        }
+        dst.A.push_back(x);
+        dst.b.push_back(rational(1));
+        dst.eq.push_back(true);
+        vector<vector<rational>> dirs;
+        ech.null_space(num_cols, dirs);
+        for (vector<rational> const& d : dirs) {
+            dst.A.push_back(d);
+            dst.b.push_back(rational(0));
+            dst.eq.push_back(true);
+        }
+        return l_true;
+    }
+
     bool karr_relation_plugin::dualizeI(matrix& dst, matrix const& src) {
         dst.reset();
+        if (src.size() > 0 && all_eqs(src)) {
+            switch (dualize_eqs(dst, src)) {
+            case l_false: return false;
+            case l_true: return true;
+            case l_undef: dst.reset(); break;
+            }
+        }
         m_hb.reset();
         for (unsigned i = 0; i < src.size(); ++i) {
             if (src.eq[i]) {
@@ -631,6 +806,26 @@ namespace datalog {
         if (src.size() == 0) {
             return;
         }
+        if (all_eqs(src)) {
+            // The equalities satisfied by the points and directions of the
+            // basis are the null space of the homogenized basis rows.
+            unsigned num_cols = src.A[0].size() + 1;
+            karr_echelon ech(num_cols);
+            for (unsigned i = 0; i < src.size(); ++i) {
+                vector<rational> row(src.A[i]);
+                row.push_back(src.b[i]);
+                ech.add(row);
+            }
+            vector<vector<rational>> eqs;
+            ech.null_space(num_cols, eqs);
+            for (vector<rational>& v : eqs) {
+                dst.b.push_back(v.back());
+                dst.eq.push_back(true);
+                v.pop_back();
+                dst.A.push_back(v);
+            }
+            return;
+        }
         m_hb.reset();
         for (unsigned i = 0; i < src.size(); ++i) {
             vector<rational> v(src.A[i]);
@@ -72,8 +72,15 @@ namespace datalog {
             unsigned col) override;
         relation_mutator_fn * mk_filter_interpreted_fn(const relation_base & t, app * condition) override;
 
-    private:
+        /**
+           \brief Compute a point and the directions of the integer solutions of src.
+           Return false if src has no solution.
+        */
         bool dualizeI(matrix& dst, matrix const& src);
+
+        /**
+           \brief Compute the constraints satisfied by the points and directions in src.
+        */
         void dualizeH(matrix& dst, matrix const& src);
 
 
@@ -36,6 +36,7 @@ Revision History:
 #include "muz/rel/check_relation.h"
 #include "muz/rel/dl_lazy_table.h"
 #include "muz/rel/dl_sparse_table.h"
+#include "muz/rel/dl_sorted_table.h"
 #include "muz/rel/dl_table.h"
 #include "muz/rel/dl_table_relation.h"
 #include "muz/rel/aig_exporter.h"
@@ -62,6 +63,8 @@ namespace datalog {
 
     public:
 
+        decl_set const& preds() const { return m_preds; }
+
         scoped_query(context& ctx):
             m_ctx(ctx),
             m_rules(ctx.get_rules()),
@@ -98,7 +101,11 @@ namespace datalog {
           m_answer(m), 
           m_last_result_relation(nullptr),
           m_ectx(ctx),
-          m_sw(0) {
+          m_sw(0),
+          m_pinned(m),
+          m_saturated_decls(m),
+          m_saturated_fmls(m),
+          m_num_incremental(0) {
 
         // register plugins for builtin tables
 
@@ -107,6 +114,7 @@ namespace datalog {
         rm.register_plugin(alloc(sparse_table_plugin, rm));
         rm.register_plugin(alloc(hashtable_table_plugin, rm));
         rm.register_plugin(alloc(bitvector_table_plugin, rm));
+        rm.register_plugin(alloc(sorted_table_plugin, rm));
         rm.register_plugin(lazy_table_plugin::mk_sparse(rm));
 
         // register plugins for builtin relations
@@ -123,6 +131,7 @@ namespace datalog {
             m_last_result_relation->deallocate();
             m_last_result_relation = nullptr;
         }        
+        reset_added_facts();
     }
 
     lbool rel_context::saturate() {
@@ -139,6 +148,7 @@ namespace datalog {
         instruction_block termination_code;
 
         lbool result;
+        bool first_round = true;
 
         TRACE("dl", m_context.display(tout););
 
@@ -167,7 +177,34 @@ namespace datalog {
             ::stopwatch sw;
             sw.start();
 
-            compiler::compile(m_context, m_context.get_rules(), m_code, termination_code);
+            func_decl_set clean_preds;
+            if (first_round && collect_clean_preds(clean_preds)) {
+                obj_map<func_decl, func_decl*> fact_deltas;
+                for (auto const& kv : m_added_facts) {
+                    func_decl* pred = kv.m_key;
+                    func_decl* delta_pred = nullptr;
+                    if (!m_fact_delta_preds.find(pred, delta_pred)) {
+                        delta_pred = m.mk_fresh_func_decl(pred->get_name(), symbol("delta"), pred->get_arity(), 
+                                                          pred->get_domain(), pred->get_range());
+                        m_pinned.push_back(pred);
+                        m_pinned.push_back(delta_pred);
+                        m_fact_delta_preds.insert(pred, delta_pred);
+                    }
+                    // the relation is removed with the other auxiliary relations at the end of the query
+                    store_relation(delta_pred, kv.m_value);
+                    fact_deltas.insert(pred, delta_pred);
+                }
+                m_added_facts.reset();
+                ++m_num_incremental;
+                compiler::compile_incremental(m_context, m_context.get_rules(), fact_deltas, clean_preds, 
+                                              m_code, termination_code);
+            }
+            else {
+                reset_added_facts();
+                compiler::compile(m_context, m_context.get_rules(), m_code, termination_code);
+            }
+            first_round = false;
+            reset_saturated();
 
             bool timeout_after_this_round = time_limit && (restart_time==0 || remaining_time_limit<=restart_time);
 
@@ -196,6 +233,7 @@ namespace datalog {
             }
             if (!early_termination) {
                 m_context.set_status(OK);
+                record_saturated(sq.preds());
                 result = l_true;
                 break;
             }
@@ -476,6 +514,8 @@ namespace datalog {
 
     void rel_context::set_predicate_representation(func_decl * pred, unsigned relation_name_cnt, 
                                                    symbol const * relation_names) {
+        reset_added_facts();
+        reset_saturated();
 
         TRACE("dl", 
               tout << pred->get_name() << ": ";
@@ -549,9 +589,125 @@ namespace datalog {
         return m_last_result_relation->contains_fact(f);
     }
  
+    void rel_context::reset_added_facts() {
+        for (auto const& kv : m_added_facts) {
+            kv.m_value->deallocate();
+        }
+        m_added_facts.reset();
+    }
+
+    void rel_context::reset_saturated() {
+        m_saturated_preds.reset();
+        m_saturated_decls.reset();
+        m_saturated_rules.reset();
+        m_saturated_fmls.reset();
+    }
+
+    /**
+       Record the rules of a successful saturation and the predicates whose relations
+       are kept after the query, that is, the predicates in \c preds.
+    */
+    void rel_context::record_saturated(decl_set const& preds) {
+        reset_saturated();
+        if (!m_context.incremental()) {
+            return;
+        }
+        rule_set const& rules = m_context.get_rules();
+        expr_ref fml(m);
+        for (rule* r : rules) {
+            m_context.get_rule_manager().to_formula(*r, fml);
+            m_saturated_fmls.push_back(fml);
+            m_saturated_rules.insert(fml);
+            func_decl* head = r->get_decl();
+            if (preds.contains(head)) {
+                m_saturated_preds.insert(head, rules.get_predicate_rules(head).size());
+            }
+            for (unsigned i = 0; i < r->get_uninterpreted_tail_size(); ++i) {
+                func_decl* q = r->get_decl(i);
+                if (preds.contains(q)) {
+                    m_saturated_preds.insert(q, rules.get_predicate_rules(q).size());
+                }
+            }
+        }
+        for (auto const& kv : m_saturated_preds) {
+            m_saturated_decls.push_back(kv.m_key);
+        }
+    }
+
+    /**
+       A predicate is clean if its relation was saturated by the last query with the
+       same rules and the predicates in the bodies of its rules are clean.
+       Predicates that depend on negation are never clean since adding facts may
+       invalidate their tuples.
+    */
+    bool rel_context::collect_clean_preds(func_decl_set& clean) {
+        if (m_saturated_preds.empty() || !m_context.incremental() || 
+            m_context.compile_with_widening() || m_context.generate_explanations()) {
+            return false;
+        }
+        rule_set const& rules = m_context.get_rules();
+        expr_ref fml(m);
+        auto is_clean = [&](func_decl* q) {
+            unsigned n = 0;
+            return clean.contains(q) || 
+                (rules.get_predicate_rules(q).empty() && m_saturated_preds.find(q, n) && n == 0);
+        };
+        for (func_decl_set* strat : rules.get_strats()) {
+            bool ok = true;
+            for (func_decl* p : *strat) {
+                unsigned n = 0;
+                rule_vector const& p_rules = rules.get_predicate_rules(p);
+                ok &= m_saturated_preds.find(p, n) && n == p_rules.size();
+                for (unsigned j = 0; ok && j < p_rules.size(); ++j) {
+                    rule* r = p_rules[j];
+                    if (r->get_positive_tail_size() < r->get_uninterpreted_tail_size()) {
+                        ok = false;
+                        break;
+                    }
+                    m_context.get_rule_manager().to_formula(*r, fml);
+                    ok = m_saturated_rules.contains(fml);
+                    for (unsigned k = 0; ok && k < r->get_uninterpreted_tail_size(); ++k) {
+                        func_decl* q = r->get_decl(k);
+                        ok = strat->contains(q) || is_clean(q);
+                    }
+                }
+                if (!ok) {
+                    break;
+                }
+            }
+            if (ok) {
+                for (func_decl* p : *strat) {
+                    clean.insert(p);
+                }
+            }
+        }
+        TRACE("dl", tout << "clean predicates:"; for (func_decl* p : clean) tout << " " << p->get_name(); tout << "\n";);
+        return !clean.empty();
+    }
+
+    void rel_context::record_added_fact(func_decl* pred, relation_fact const* rfact, table_fact const* tfact) {
+        if (!m_saturated_preds.contains(pred)) {
+            return;
+        }
+        relation_base* delta = nullptr;
+        if (!m_added_facts.find(pred, delta)) {
+            relation_base& rel = get_relation(pred);
+            delta = rel.get_plugin().mk_empty(rel);
+            m_added_facts.insert(pred, delta);
+        }
+        if (rfact) {
+            delta->add_fact(*rfact);
+        }
+        else {
+            SASSERT(delta->from_table());
+            static_cast<table_relation*>(delta)->add_table_fact(*tfact);
+        }
+    }
+
     void rel_context::add_fact(func_decl* pred, relation_fact const& fact) {
         get_rmanager().reset_saturated_marks();
         get_relation(pred).add_fact(fact);
+        record_added_fact(pred, &fact, nullptr);
         if (!m_context.print_aig().is_null()) {
             m_table_facts.push_back(std::make_pair(pred, fact));
         }
@@ -563,6 +719,7 @@ namespace datalog {
         if (rel0.from_table()) {
             table_relation & rel = static_cast<table_relation &>(rel0);
             rel.add_table_fact(fact);
+            record_added_fact(pred, nullptr, &fact);
             // TODO: table facts?
         }
         else {
@@ -585,6 +742,7 @@ namespace datalog {
 
     void rel_context::collect_statistics(statistics& st) const {
         st.update("saturation time", m_sw);
+        st.update("incremental saturations", m_num_incremental);
         m_code.collect_statistics(st);
         m_ectx.collect_statistics(st);
     }
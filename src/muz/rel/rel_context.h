@@ -42,9 +42,25 @@ namespace datalog {
         instruction_block  m_code;
         double             m_sw;
 
+        // state for incremental saturation
+        obj_map<func_decl, relation_base*> m_added_facts;       // facts added since the last saturation
+        obj_map<func_decl, func_decl*>     m_fact_delta_preds;  // predicates that hold m_added_facts during saturation
+        func_decl_ref_vector               m_pinned;
+        obj_map<func_decl, unsigned>       m_saturated_preds;   // predicates saturated by the last query, with their number of rules
+        func_decl_ref_vector               m_saturated_decls;
+        obj_hashtable<expr>                m_saturated_rules;
+        expr_ref_vector                    m_saturated_fmls;
+        unsigned                           m_num_incremental;
+
         class scoped_query;
 
         void reset_negated_tables();
+
+        void record_added_fact(func_decl* pred, relation_fact const* rfact, table_fact const* tfact);
+        void reset_added_facts();
+        void reset_saturated();
+        void record_saturated(decl_set const& preds);
+        bool collect_clean_preds(func_decl_set& clean);
         
         relation_plugin & get_ordinary_relation_plugin(symbol relation_name);
         
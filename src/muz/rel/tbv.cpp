@@ -22,6 +22,197 @@ Revision History:
 #include "util/hashtable.h"
 #include "ast/ast_util.h"
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define TBV_SSE2
+#include <emmintrin.h>
+#endif
+#if defined(TBV_SSE2) && (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define TBV_AVX2
+#include <immintrin.h>
+#endif
+
+/**
+   Word kernels for the operations that dominate doc and udoc relations.
+   They work on all words of a tbv except the last one, which may be
+   partially used and is handled by the callers with the mask of the
+   manager. A tbit is a pair of bits, 00 is BIT_z, so a word is well
+   formed when every pair has a bit set.
+*/
+struct tbv_manager::kernels {
+    char const* m_name;
+    // dst &= src, return true if the result has no BIT_z
+    bool (*m_meet)(unsigned* dst, unsigned const* src, unsigned n);
+    bool (*m_well_formed)(unsigned const* a, unsigned n);
+    bool (*m_equals)(unsigned const* a, unsigned const* b, unsigned n);
+    // every word of b is contained in the corresponding word of a
+    bool (*m_contains)(unsigned const* a, unsigned const* b, unsigned n);
+};
+
+namespace {
+
+    const unsigned s_odd = 0x55555555;
+
+    bool meet_scalar(unsigned* dst, unsigned const* src, unsigned n) {
+        unsigned ok = 0xFFFFFFFF;
+        for (unsigned i = 0; i < n; ++i) {
+            unsigned w = (dst[i] &= src[i]);
+            ok &= w | (w << 1) | s_odd;
+        }
+        return ok == 0xFFFFFFFF;
+    }
+
+    bool well_formed_scalar(unsigned const* a, unsigned n) {
+        unsigned ok = 0xFFFFFFFF;
+        for (unsigned i = 0; i < n; ++i)
+            ok &= a[i] | (a[i] << 1) | s_odd;
+        return ok == 0xFFFFFFFF;
+    }
+
+    bool equals_scalar(unsigned const* a, unsigned const* b, unsigned n) {
+        for (unsigned i = 0; i < n; ++i)
+            if (a[i] != b[i])
+                return false;
+        return true;
+    }
+
+    bool contains_scalar(unsigned const* a, unsigned const* b, unsigned n) {
+        for (unsigned i = 0; i < n; ++i)
+            if ((a[i] & b[i]) != b[i])
+                return false;
+        return true;
+    }
+
+#ifdef TBV_SSE2
+    inline __m128i load128(unsigned const* p) { return _mm_loadu_si128(reinterpret_cast<__m128i const*>(p)); }
+
+    inline bool all_ones128(__m128i v) {
+        return _mm_movemask_epi8(_mm_cmpeq_epi32(v, _mm_set1_epi32(-1))) == 0xFFFF;
+    }
+
+    bool meet_sse2(unsigned* dst, unsigned const* src, unsigned n) {
+        __m128i ok = _mm_set1_epi32(-1), odd = _mm_set1_epi32(s_odd);
+        unsigned i = 0;
+        for (; i + 4 <= n; i += 4) {
+            __m128i w = _mm_and_si128(load128(dst + i), load128(src + i));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), w);
+            ok = _mm_and_si128(ok, _mm_or_si128(_mm_or_si128(w, _mm_slli_epi32(w, 1)), odd));
+        }
+        bool tail = meet_scalar(dst + i, src + i, n - i);
+        return all_ones128(ok) && tail;
+    }
+
+    bool well_formed_sse2(unsigned const* a, unsigned n) {
+        __m128i ok = _mm_set1_epi32(-1), odd = _mm_set1_epi32(s_odd);
+        unsigned i = 0;
+        for (; i + 4 <= n; i += 4) {
+            __m128i w = load128(a + i);
+            ok = _mm_and_si128(ok, _mm_or_si128(_mm_or_si128(w, _mm_slli_epi32(w, 1)), odd));
+        }
+        return all_ones128(ok) && well_formed_scalar(a + i, n - i);
+    }
+
+    bool equals_sse2(unsigned const* a, unsigned const* b, unsigned n) {
+        unsigned i = 0;
+        for (; i + 4 <= n; i += 4)
+            if (_mm_movemask_epi8(_mm_cmpeq_epi32(load128(a + i), load128(b + i))) != 0xFFFF)
+                return false;
+        return equals_scalar(a + i, b + i, n - i);
+    }
+
+    bool contains_sse2(unsigned const* a, unsigned const* b, unsigned n) {
+        unsigned i = 0;
+        for (; i + 4 <= n; i += 4) {
+            __m128i w = load128(b + i);
+            if (_mm_movemask_epi8(_mm_cmpeq_epi32(_mm_and_si128(load128(a + i), w), w)) != 0xFFFF)
+                return false;
+        }
+        return contains_scalar(a + i, b + i, n - i);
+    }
+#endif
+
+#ifdef TBV_AVX2
+#define TBV_TARGET_AVX2 __attribute__((target("avx2")))
+
+    TBV_TARGET_AVX2 inline __m256i load256(unsigned const* p) {
+        return _mm256_loadu_si256(reinterpret_cast<__m256i const*>(p));
+    }
+
+    TBV_TARGET_AVX2 inline bool all_ones256(__m256i v) {
+        return _mm256_movemask_epi8(_mm256_cmpeq_epi32(v, _mm256_set1_epi32(-1))) == -1;
+    }
+
+    TBV_TARGET_AVX2 bool meet_avx2(unsigned* dst, unsigned const* src, unsigned n) {
+        __m256i ok = _mm256_set1_epi32(-1), odd = _mm256_set1_epi32(s_odd);
+        unsigned i = 0;
+        for (; i + 8 <= n; i += 8) {
+            __m256i w = _mm256_and_si256(load256(dst + i), load256(src + i));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), w);
+            ok = _mm256_and_si256(ok, _mm256_or_si256(_mm256_or_si256(w, _mm256_slli_epi32(w, 1)), odd));
+        }
+        bool tail = meet_scalar(dst + i, src + i, n - i);
+        return all_ones256(ok) && tail;
+    }
+
+    TBV_TARGET_AVX2 bool well_formed_avx2(unsigned const* a, unsigned n) {
+        __m256i ok = _mm256_set1_epi32(-1), odd = _mm256_set1_epi32(s_odd);
+        unsigned i = 0;
+        for (; i + 8 <= n; i += 8) {
+            __m256i w = load256(a + i);
+            ok = _mm256_and_si256(ok, _mm256_or_si256(_mm256_or_si256(w, _mm256_slli_epi32(w, 1)), odd));
+        }
+        return all_ones256(ok) && well_formed_scalar(a + i, n - i);
+    }
+
+    TBV_TARGET_AVX2 bool equals_avx2(unsigned const* a, unsigned const* b, unsigned n) {
+        unsigned i = 0;
+        for (; i + 8 <= n; i += 8)
+            if (_mm256_movemask_epi8(_mm256_cmpeq_epi32(load256(a + i), load256(b + i))) != -1)
+                return false;
+        return equals_scalar(a + i, b + i, n - i);
+    }
+
+    TBV_TARGET_AVX2 bool contains_avx2(unsigned const* a, unsigned const* b, unsigned n) {
+        unsigned i = 0;
+        for (; i + 8 <= n; i += 8) {
+            __m256i w = load256(b + i);
+            if (_mm256_movemask_epi8(_mm256_cmpeq_epi32(_mm256_and_si256(load256(a + i), w), w)) != -1)
+                return false;
+        }
+        return contains_scalar(a + i, b + i, n - i);
+    }
+#endif
+}
+
+tbv_manager::kernels const* tbv_manager::select_kernels(bool simd) {
+    static const kernels scalar_kernels = {
+        "scalar", meet_scalar, well_formed_scalar, equals_scalar, contains_scalar
+    };
+#ifdef TBV_AVX2
+    static const kernels avx2_kernels = {
+        "avx2", meet_avx2, well_formed_avx2, equals_avx2, contains_avx2
+    };
+    static const bool has_avx2 = (__builtin_cpu_init(), __builtin_cpu_supports("avx2") != 0);
+    if (simd && has_avx2)
+        return &avx2_kernels;
+#endif
+#ifdef TBV_SSE2
+    static const kernels sse2_kernels = {
+        "sse2", meet_sse2, well_formed_sse2, equals_sse2, contains_sse2
+    };
+    if (simd)
+        return &sse2_kernels;
+#endif
+    return &scalar_kernels;
+}
+
+void tbv_manager::set_simd(bool f) {
+    m_kernels = select_kernels(f);
+}
+
+char const* tbv_manager::kernels_name() const {
+    return m_kernels->m_name;
+}
+
 
 static bool s_debug_alloc = false;
 
@@ -208,24 +399,22 @@ tbv& tbv_manager::set_or(tbv& dst,  tbv const& src) const {
     return dst;
 }
 bool tbv_manager::set_and(tbv& dst,  tbv const& src) const {
-    m.set_and(dst, src); 
-    return is_well_formed(dst);
+    unsigned nw = m.num_words();
+    if (nw == 0) return true;
+    bool ok = m_kernels->m_meet(dst.m_data, src.m_data, nw - 1);
+    dst.m_data[nw - 1] &= src.m_data[nw - 1];
+    unsigned w = m.last_word(dst);
+    w = w | (w << 1) | 0x55555555 | ~m.get_mask();
+    return ok && w == 0xFFFFFFFF;
 }
 
 bool tbv_manager::is_well_formed(tbv const& dst) const {
     unsigned nw = m.num_words();
-    unsigned w;
-    for (unsigned i = 0; i + 1 < nw; ++i) {
-        w = dst.get_word(i);
-        w = w | (w << 1) | 0x55555555;
-        if (w != 0xFFFFFFFF) return false;
-    }
-    if (nw > 0) {        
-        w = m.last_word(dst);
-        w = w | (w << 1) | 0x55555555 | ~m.get_mask();
-        if (w != 0xFFFFFFFF) return false;
-    }
-    return true;
+    if (nw == 0) return true;
+    if (!m_kernels->m_well_formed(dst.m_data, nw - 1)) return false;
+    unsigned w = m.last_word(dst);
+    w = w | (w << 1) | 0x55555555 | ~m.get_mask();
+    return w == 0xFFFFFFFF;
 }
 
 void tbv_manager::complement(tbv const& src, ptr_vector<tbv>& result) {
@@ -250,13 +439,20 @@ void tbv_manager::complement(tbv const& src, ptr_vector<tbv>& result) {
 }
 
 bool tbv_manager::equals(tbv const& a, tbv const& b) const {
-    return m.equals(a, b);
+    if (&a == &b) return true;
+    unsigned nw = m.num_words();
+    if (nw == 0) return true;
+    return m_kernels->m_equals(a.m_data, b.m_data, nw - 1) && m.last_word(a) == m.last_word(b);
 }
 unsigned tbv_manager::hash(tbv const& src) const {
     return m.hash(src);
 }
 bool tbv_manager::contains(tbv const& a, tbv const& b) const {
-    return m.contains(a, b);
+    unsigned nw = m.num_words();
+    if (nw == 0) return true;
+    if (!m_kernels->m_contains(a.m_data, b.m_data, nw - 1)) return false;
+    unsigned lb = m.last_word(b);
+    return (m.last_word(a) & lb) == lb;
 }
 
 bool tbv_manager::contains(tbv const& a, unsigned_vector const& colsa,
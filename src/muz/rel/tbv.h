@@ -39,11 +39,20 @@ inline tbit neg(tbit t) {
 
 class tbv_manager {
     friend class tbv;
+    struct kernels;
     fixed_bit_vector_manager m;
     ptr_vector<tbv> allocated_tbvs;
+    kernels const*  m_kernels;
+    static kernels const* select_kernels(bool simd);
 public:
-    tbv_manager(unsigned n): m(2*n) {}
+    tbv_manager(unsigned n): m(2*n), m_kernels(select_kernels(true)) {}
     ~tbv_manager();
+    /**
+       \brief Use the SIMD kernels for meet, equality and subsumption that
+       the CPU supports, or the word by word ones if f is false.
+    */
+    void set_simd(bool f);
+    char const* kernels_name() const;
     void reset();
     tbv* allocate();
     tbv* allocate1();
@@ -88,6 +88,7 @@ void limit_num_generalizer::operator()(lemma_ref &lemma) {
 
     m_st.count++;
     scoped_watch _w_(m_st.watch);
+    profiler::scope _p(m_ctx.get_profiler(), "generalize.limit_num");
 
     unsigned uses_level;
     pred_transformer &pt = lemma->get_pob()->pt();
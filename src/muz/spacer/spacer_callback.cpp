@@ -19,6 +19,7 @@ Notes:
 
 #include "spacer_callback.h"
 #include "muz/spacer/spacer_context.h"
+#include "ast/ast_translation.h"
 
 
 namespace spacer {
@@ -35,4 +36,52 @@ namespace spacer {
         m_unfold_eh(m_state);
     }
 
-}
\ No newline at end of file
+    void lemma_store::publish(unsigned source, ast_manager& src, expr* lemma, unsigned level) {
+        lock_guard lock(m_mux);
+        ast_translation tr(src, m);
+        expr_ref l(tr(lemma), m);
+        unsigned max_level = 0;
+        if (m_max_level.find(l, max_level) && level <= max_level)
+            return;
+        m_max_level.insert(l, level);
+        m_lemmas.push_back(l);
+        m_levels.push_back(level);
+        m_sources.push_back(source);
+    }
+
+    unsigned lemma_store::fetch(unsigned id, unsigned head, ast_manager& dst,
+                                expr_ref_vector& lemmas, unsigned_vector& levels) {
+        lock_guard lock(m_mux);
+        ast_translation tr(m, dst);
+        for (; head < m_lemmas.size(); ++head) {
+            if (m_sources[head] == id)
+                continue;
+            lemmas.push_back(tr(m_lemmas.get(head)));
+            levels.push_back(m_levels[head]);
+        }
+        return head;
+    }
+
+    void lemma_exchange::new_lemma_eh(expr *lemma, unsigned level) {
+        m_store.publish(m_id, m_context.get_ast_manager(), lemma, level);
+    }
+
+    void lemma_exchange::unfold_eh() {
+        ast_manager& m = m_context.get_ast_manager();
+        expr_ref_vector lemmas(m);
+        unsigned_vector levels;
+        m_head = m_store.fetch(m_id, m_head, m, lemmas, levels);
+        flet<bool> _importing(m_importing, true);
+        for (unsigned i = 0; i < lemmas.size(); ++i) {
+            // lemmas have the form head(sig) => lemma, see context::new_lemma_eh
+            expr *head = nullptr, *body = nullptr;
+            if (!m.is_implies(lemmas.get(i), head, body) || !is_app(head))
+                continue;
+            unsigned level = levels[i];
+            m_context.add_cover(is_infty_level(level) ? -1 : static_cast<int>(level),
+                                to_app(head)->get_decl(), body);
+            ++m_num_imported;
+        }
+    }
+
+}
@@ -19,6 +19,7 @@ Notes:
 
 #pragma once
 
+#include "util/mutex.h"
 #include "muz/spacer/spacer_context.h"
 #include "muz/base/dl_engine_base.h"
 
@@ -58,6 +59,63 @@ namespace spacer {
 
     };
 
+    /**
+       \brief Lemmas published by Spacer instances that run in parallel.
+
+       The lemmas are kept in a manager of their own. Instances translate
+       to and from it while holding the lock, so no manager is ever used
+       by two threads at once.
+    */
+    class lemma_store {
+        mutex           m_mux;
+        ast_manager&    m;
+        expr_ref_vector m_lemmas;
+        unsigned_vector m_levels;
+        unsigned_vector m_sources;
+        obj_map<expr, unsigned> m_max_level;    // highest level a lemma was published at
+    public:
+        lemma_store(ast_manager& m): m(m), m_lemmas(m) {}
+        /**
+           \brief Add a lemma unless it was published at the same or a higher
+           level before. Contexts report lemmas they re-derive as well, and
+           passing those on would make the other instances count them as
+           lemmas they are stuck on.
+        */
+        void publish(unsigned source, ast_manager& src, expr* lemma, unsigned level);
+        /**
+           \brief Translate the lemmas from position head onwards that were not
+           published by instance id into dst. Return the new head.
+        */
+        unsigned fetch(unsigned id, unsigned head, ast_manager& dst,
+                       expr_ref_vector& lemmas, unsigned_vector& levels);
+    };
+
+    /**
+       \brief Publish the lemmas of a context to a lemma_store and add the
+       lemmas published by other instances whenever the context enters a
+       new level.
+    */
+    class lemma_exchange : public spacer_callback {
+        lemma_store& m_store;
+        unsigned     m_id;
+        unsigned     m_head = 0;
+        bool         m_importing = false;
+        unsigned     m_num_imported = 0;
+    public:
+        lemma_exchange(context& ctx, lemma_store& store, unsigned id):
+            spacer_callback(ctx), m_store(store), m_id(id) {}
+
+        bool new_lemma() override { return !m_importing; }
+
+        void new_lemma_eh(expr* lemma, unsigned level) override;
+
+        bool unfold() override { return true; }
+
+        void unfold_eh() override;
+
+        unsigned num_imported() const { return m_num_imported; }
+    };
+
 }
 
 
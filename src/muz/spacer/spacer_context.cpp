@@ -702,6 +702,7 @@ pred_transformer::pred_transformer(context& ctx, manager& pm, func_decl* head):
 {
     m_solver = alloc(prop_solver, m, ctx.mk_solver0(), ctx.mk_solver1(),
                      ctx.get_params(), head->get_name());
+    m_solver->set_profiler(ctx.get_profiler());
     init_sig ();
 
     m_extend_lit = mk_extend_lit();
@@ -748,6 +749,7 @@ void pred_transformer::collect_statistics(statistics& st) const
     st.update("SPACER num ctp blocked", m_stats.m_num_ctp_blocked);
     st.update("SPACER num is_invariant", m_stats.m_num_is_invariant);
     st.update("SPACER num lemma jumped", m_stats.m_num_lemma_level_jump);
+    st.update("SPACER num batch push", m_stats.m_num_batch_push);
 
     // -- time in rule initialization
     st.update ("time.spacer.init_rules.pt.init", m_initialize_watch.get_seconds ());
@@ -1322,6 +1324,7 @@ bool pred_transformer::is_qblocked (pob &n) {
 void pred_transformer::mbp(app_ref_vector &vars, expr_ref &fml, model &mdl,
                            bool reduce_all_selects, bool force) {
     scoped_watch _t_(m_mbp_watch);
+    profiler::scope _p(ctx.get_profiler(), "mbp", head());
     qe_project(m, vars, fml, mdl, reduce_all_selects, use_native_mbp(), !force);
 }
 
@@ -1431,6 +1434,7 @@ bool pred_transformer::is_ctp_blocked(lemma *lem) {
 
     if (!lem->has_ctp()) {return false;}
     scoped_watch _t_(m_ctp_watch);
+    profiler::scope _p(ctx.get_profiler(), "ctp", head(), lem->level());
 
     model_ref &ctp = lem->get_ctp();
 
@@ -1519,6 +1523,72 @@ bool pred_transformer::is_invariant(unsigned level, lemma* lem,
     return r == l_false;
 }
 
+void pred_transformer::is_invariant(unsigned level, lemma_ref_vector& lemmas,
+                                    unsigned& solver_level)
+{
+    // the query is as weak as the weakest lemma allows
+    unsigned weakness = 0, j = 0;
+    for (lemma* lem : lemmas) {
+        if (lem->is_blocked()) continue;
+        m_stats.m_num_is_invariant++;
+        if (is_ctp_blocked(lem)) {
+            m_stats.m_num_ctp_blocked++;
+            continue;
+        }
+        weakness = std::max(weakness, lem->weakness());
+        lemmas.set(j++, lem);
+    }
+    lemmas.shrink(j);
+    solver_level = level;
+
+    prop_solver::scoped_level _sl(*m_solver, level);
+    prop_solver::scoped_subset_core _sc (*m_solver, true);
+    prop_solver::scoped_weakness _sw (*m_solver, 1,
+                                      ctx.weak_abs() ? weakness : UINT_MAX);
+    while (!lemmas.empty()) {
+        m_stats.m_num_batch_push++;
+        expr_ref_vector fmls(m), cand(m), aux(m), conj(m);
+        for (lemma* lem : lemmas) fmls.push_back(lem->get_expr());
+        cand.push_back(mk_not(m, mk_and(fmls)));
+
+        model_ref mdl;
+        m_solver->set_core(nullptr);
+        m_solver->set_model(&mdl);
+        conj.push_back(m_extend_lit);
+        if (ctx.use_bg_invs()) get_pred_bg_invs(conj);
+
+        lbool r = m_solver->check_assumptions (cand, aux, m_transition_clause,
+                                               conj.size(), conj.data(), 1);
+        if (r == l_false) {
+            solver_level = m_solver->uses_level ();
+            for (lemma* lem : lemmas) lem->reset_ctp();
+            if (level < solver_level) {m_stats.m_num_lemma_level_jump++;}
+            return;
+        }
+        if (r == l_undef || !mdl) {
+            lemmas.reset();
+            return;
+        }
+        // drop the lemmas that do not hold in the model and check the rest
+        model::scoped_model_completion _smc(*mdl, true);
+        j = 0;
+        for (lemma* lem : lemmas) {
+            if (mdl->is_false(lem->get_expr())) {
+                if (ctx.use_ctp()) {lem->set_ctp(mdl);}
+            }
+            else {
+                lemmas.set(j++, lem);
+            }
+        }
+        if (j == lemmas.size()) {
+            // the model does not tell which lemmas fail, push none of them
+            lemmas.reset();
+            return;
+        }
+        lemmas.shrink(j);
+    }
+}
+
 bool pred_transformer::check_inductive(unsigned level, expr_ref_vector& state,
                                        unsigned& uses_level, unsigned weakness)
 {
@@ -2082,6 +2152,32 @@ bool pred_transformer::frames::propagate_to_next_level (unsigned level)
     unsigned tgt_level = next_level (level);
     m_pt.ensure_level (tgt_level);
 
+    if (m_pt.get_context().batch_push()) {
+        lemma_ref_vector cands;
+        bool ground = true;
+        for (unsigned i = 0, sz = m_lemmas.size(); i < sz && m_lemmas [i]->level() <= level; ++i) {
+            if (m_lemmas [i]->level () < level) continue;
+            cands.push_back(m_lemmas.get(i));
+            ground &= m_lemmas [i]->is_ground ();
+        }
+        // the lemmas are checked as one formula, which needs ground lemmas
+        if (cands.size () > 1 && ground) {
+            unsigned num_cands = cands.size ();
+            unsigned solver_level;
+            m_pt.is_invariant(tgt_level, cands, solver_level);
+            for (lemma *lem : cands) {
+                lem->set_level (solver_level);
+                m_pt.add_lemma_core (lem);
+                ++m_pt.m_stats.m_num_propagations;
+            }
+            if (!cands.empty()) {
+                m_sorted = false;
+                sort ();
+            }
+            return cands.size () == num_cands;
+        }
+    }
+
     for (unsigned i = 0, sz = m_lemmas.size(); i < sz && m_lemmas [i]->level() <= level;) {
         if (m_lemmas [i]->level () < level) {++i; continue;}
 
@@ -2318,6 +2414,8 @@ void context::updt_params() {
     m_use_euf_gen = m_params.spacer_use_euf_gen();
     m_use_lim_num_gen = m_params.spacer_use_lim_num_gen();
     m_use_ctp = m_params.spacer_ctp();
+    m_batch_push = m_params.spacer_batch_push();
+    m_profiler.set_enabled(m_params.spacer_profile_file().is_non_empty_string());
     m_use_inc_clause = m_params.spacer_use_inc_clause();
     m_blast_term_ite_inflation = m_params.spacer_blast_term_ite_inflation();
     m_use_ind_gen = m_params.spacer_use_inductive_generalizer();
@@ -2708,6 +2806,7 @@ void context::simplify_formulas() {
 lbool context::solve(unsigned from_lvl)
 {
     m_last_result = l_undef;
+    m_profiler.reset();
     try {
         if (m_use_gpdr) {
             SASSERT(from_lvl == 0);
@@ -2740,6 +2839,11 @@ lbool context::solve(unsigned from_lvl)
         VERIFY (validate ());
     } catch (const unknown_exception &)
     {}
+    catch (...) {
+        // keep the profile of runs that time out or are cancelled
+        dump_profile();
+        throw;
+    }
 
     if (m_last_result == l_true) {
         m_stats.m_cex_depth = get_cex_depth ();
@@ -2751,6 +2855,7 @@ lbool context::solve(unsigned from_lvl)
         st.display_smt2 (verbose_stream ());
     }
 
+    dump_profile();
     return m_last_result;
 }
 
@@ -3326,6 +3431,16 @@ bool context::is_reachable(pob &n)
     return next ? is_reachable(*next) : true;
 }
 
+void context::dump_profile()
+{
+    if (m_profiler.enabled()) {
+        std::ofstream of;
+        of.open(m_params.spacer_profile_file().bare_str());
+        m_profiler.display_chrome_trace(of);
+        of.close();
+    }
+}
+
 void context::dump_json()
 {
     if (m_params.spacer_print_json().is_non_empty_string()) {
@@ -3442,6 +3557,7 @@ lbool context::expand_pob(pob& n, pob_ref_buffer &out)
 {
     SASSERT(out.empty());
     pob::on_expand_event _evt(n);
+    profiler::scope _p(&m_profiler, "expand_pob", n.pt().head(), n.level());
 
     log_expand_pob(n);
 
@@ -3583,6 +3699,7 @@ lbool context::expand_pob(pob& n, pob_ref_buffer &out)
         lemma_ref lemma = alloc(class lemma, pob_ref(&n), cube, uses_level);
 
         // -- run all lemma generalizers
+        profiler::scope _pg(&m_profiler, "generalize");
         for (unsigned i = 0;
              // -- only generalize if lemma was constructed using farkas
              n.use_farkas_generalizer () && !lemma->is_false() &&
@@ -3712,6 +3829,7 @@ bool context::propagate(unsigned min_prop_lvl,
         for (auto & kv : m_rels) {
             checkpoint();
             pred_transformer& r = *kv.m_value;
+            profiler::scope _p(&m_profiler, "propagate", r.head(), lvl);
             all_propagated = r.propagate_to_next_level(lvl) && all_propagated;
         }
         //CASSERT("spacer", check_invariant(lvl));
@@ -4101,14 +4219,16 @@ void context::new_lemma_eh(pred_transformer &pt, lemma *lem) {
     }
     if (!handle)
         return;
-    if ((is_infty_level(lem->level()) && m_params.spacer_p3_share_invariants()) ||
-        (!is_infty_level(lem->level()) && m_params.spacer_p3_share_lemmas())) {
+    // parallel instances share all their lemmas, see lemma_exchange
+    bool share = m_params.spacer_threads() > 1;
+    if ((is_infty_level(lem->level()) && (share || m_params.spacer_p3_share_invariants())) ||
+        (!is_infty_level(lem->level()) && (share || m_params.spacer_p3_share_lemmas()))) {
         expr_ref_vector args(m);
         for (unsigned i = 0; i < pt.sig_size(); ++i) {
             args.push_back(m.mk_const(pt.get_manager().o2n(pt.sig(i), 0)));
         }
-        expr *app = m.mk_app(pt.head(), pt.sig_size(), args.data());
-        expr *lemma = m.mk_implies(app, lem->get_expr());
+        expr_ref app(m.mk_app(pt.head(), pt.sig_size(), args.data()), m);
+        expr_ref lemma(m.mk_implies(app, lem->get_expr()), m);
         for (unsigned i = 0; i < m_callbacks.size(); i++) {
             if (m_callbacks[i]->new_lemma())
                 m_callbacks[i]->new_lemma_eh(lemma, lem->level());
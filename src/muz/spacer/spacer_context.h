@@ -30,6 +30,7 @@ Notes:
 #include "muz/spacer/spacer_manager.h"
 #include "muz/spacer/spacer_prop_solver.h"
 #include "muz/spacer/spacer_json.h"
+#include "muz/spacer/spacer_profiler.h"
 
 #include "muz/base/fp_params.hpp"
 
@@ -212,6 +213,7 @@ class pred_transformer {
         unsigned m_num_is_invariant; // num of times lemmas are pushed
         unsigned m_num_lemma_level_jump; // lemma learned at higher level than expected
         unsigned m_num_reach_queries;
+        unsigned m_num_batch_push; // num of queries that push several lemmas at once
 
         stats() { reset(); }
         void reset() { memset(this, 0, sizeof(*this)); }
@@ -538,6 +540,11 @@ public:
                       unsigned& solver_level,
                       expr_ref_vector* core = nullptr);
 
+    /// \brief Keep in lemmas those that can be pushed from frame level.
+    /// The lemmas are checked together, see frames::propagate_to_next_level
+    void is_invariant(unsigned level, lemma_ref_vector& lemmas,
+                      unsigned& solver_level);
+
     bool is_invariant(unsigned level, expr* lem,
                       unsigned& solver_level, expr_ref_vector* core = nullptr) {
         // XXX only needed for legacy_frames to compile
@@ -958,6 +965,7 @@ class context {
     bool                 m_use_euf_gen;
     bool                 m_use_lim_num_gen;
     bool                 m_use_ctp;
+    bool                 m_batch_push;
     bool                 m_use_inc_clause;
     bool                 m_use_ind_gen;
     bool                 m_use_array_eq_gen;
@@ -984,6 +992,7 @@ class context {
     unsigned             m_blast_term_ite_inflation;
     scoped_ptr_vector<spacer_callback> m_callbacks;
     json_marshaller      m_json_marshaller;
+    profiler             m_profiler;
     std::fstream*        m_trace_stream;
 
     // Solve using gpdr strategy
@@ -1047,6 +1056,7 @@ class context {
     void simplify_formulas();
 
     void dump_json();
+    void dump_profile();
 
     void predecessor_eh();
 
@@ -1074,6 +1084,8 @@ public:
     bool use_lim_num_gen() const {return m_use_lim_num_gen;}
     bool simplify_pob() const {return m_simplify_pob;}
     bool use_ctp() const {return m_use_ctp;}
+    bool batch_push() const {return m_batch_push;}
+    profiler* get_profiler() {return &m_profiler;}
     bool use_inc_clause() const {return m_use_inc_clause;}
     unsigned blast_term_ite_inflation() const {return m_blast_term_ite_inflation;}
     bool elim_aux() const {return m_elim_aux;}
@@ -35,6 +35,11 @@ Revision History:
 #include "ast/scoped_proof.h"
 #include "muz/transforms/dl_transforms.h"
 #include "muz/spacer/spacer_callback.h"
+#include "ast/ast_translation.h"
+#include "smt/params/smt_params.h"
+#ifndef SINGLE_THREAD
+#include <thread>
+#endif
 
 using namespace spacer;
 
@@ -164,10 +169,156 @@ lbool dl_interface::query(expr * query)
         return l_false;
     }
 
-    return m_context->solve(m_ctx.get_params().spacer_min_level());
+    return solve(m_ctx.get_params().spacer_min_level());
 
 }
 
+#ifdef SINGLE_THREAD
+
+lbool dl_interface::solve(unsigned from_lvl)
+{
+    return m_context->solve(from_lvl);
+}
+
+#else
+
+namespace {
+    // helper instances never create engines of their own
+    class null_register_engine : public datalog::register_engine_base {
+    public:
+        datalog::engine_base* mk_engine(datalog::DL_ENGINE engine_type) override { return nullptr; }
+        void set_context(datalog::context* ctx) override {}
+    };
+
+    /**
+       \brief A Spacer instance over a private copy of the rules that
+       runs next to the main instance and exchanges lemmas with it.
+    */
+    struct helper {
+        ast_manager             m;
+        smt_params              m_fparams;
+        null_register_engine    m_register;
+        datalog::context        m_ctx;
+        datalog::rule_set       m_rules;
+        scoped_ptr<context>     m_spacer;
+
+        helper(datalog::context& src, datalog::rule_set const& rules, func_decl* query,
+               params_ref const& p) :
+            m(src.get_manager(), true),
+            m_ctx(m, m_register, m_fparams, p),
+            m_rules(m_ctx) {
+            ast_translation tr(src.get_manager(), m);
+            datalog::rule_manager& rm = m_ctx.get_rule_manager();
+            ptr_vector<app> tail;
+            bool_vector neg;
+            // rule_manager::mk tells predicates from interpreted tails by
+            // the predicates registered with the context
+            for (datalog::rule* r : rules) {
+                m_ctx.register_predicate(tr(r->get_decl()), false);
+                for (unsigned i = 0; i < r->get_uninterpreted_tail_size(); ++i)
+                    m_ctx.register_predicate(tr(r->get_decl(i)), false);
+            }
+            m_ctx.register_predicate(tr(query), false);
+            for (datalog::rule* r : rules) {
+                tail.reset();
+                neg.reset();
+                for (unsigned i = 0; i < r->get_tail_size(); ++i) {
+                    tail.push_back(tr(r->get_tail(i)));
+                    neg.push_back(r->is_neg_tail(i));
+                }
+                m_rules.add_rule(rm.mk(tr(r->get_head()), tail.size(), tail.data(),
+                                       neg.data(), r->name(), false));
+            }
+            func_decl* q = tr(query);
+            m_rules.set_output_predicate(q);
+            m_rules.close();
+            m_spacer = alloc(context, m_ctx.get_params(), m);
+            m_spacer->set_query(q);
+        }
+    };
+}
+
+/**
+   Run the main instance on the calling thread and spacer.threads - 1
+   helper instances next to it. Each helper works on its own manager
+   and uses a different random seed and order of children. All instances
+   publish their lemmas to a shared store and add the lemmas of the
+   others when they enter a new level. The answer, model and certificate
+   are always those of the main instance; the helpers are cancelled once
+   it is done.
+*/
+lbool dl_interface::solve(unsigned from_lvl)
+{
+    unsigned num_threads = m_ctx.get_params().spacer_threads();
+    ast_manager& m = m_ctx.get_manager();
+    if (num_threads <= 1 || m_spacer_rules.get_num_rules() == 0)
+        return m_context->solve(from_lvl);
+    if (m.has_trace_stream())
+        throw default_exception("trace streams have to be off in parallel mode");
+
+    ast_manager store_m(m, true);
+    lemma_store store(store_m);
+    scoped_ptr_vector<helper> helpers;
+    scoped_limits sl(m.limit());
+    unsigned seed = m_ctx.get_params().spacer_random_seed();
+    for (unsigned i = 1; i < num_threads; ++i) {
+        params_ref p;
+        p.copy(m_ctx.get_params_ref());
+        p.set_uint("spacer.random_seed", seed + i);
+        p.set_uint("spacer.order_children", i % 3);
+        // only the main instance writes the profile
+        p.set_sym("spacer.profile_file", symbol(""));
+        helper* h = alloc(helper, m_ctx, m_spacer_rules, m_spacer_rules.get_output_predicate(), p);
+        helpers.push_back(h);
+        sl.push_child(&h->m.limit());
+        h->m_spacer->update_rules(h->m_rules);
+        h->m_spacer->callbacks().push_back(alloc(lemma_exchange, *h->m_spacer, store, i));
+    }
+    lemma_exchange* main_exchange = alloc(lemma_exchange, *m_context, store, 0);
+    m_context->callbacks().push_back(main_exchange);
+
+    vector<std::thread> threads(helpers.size());
+    for (unsigned i = 0; i < helpers.size(); ++i) {
+        threads[i] = std::thread([&, i]() {
+            helper& h = *helpers[i];
+            try {
+                h.m_spacer->solve(from_lvl);
+            }
+            catch (z3_exception& ex) {
+                // helpers only contribute lemmas, their failures do not matter
+                if (h.m.inc())
+                    IF_VERBOSE(1, verbose_stream() << "(spacer.thread " << (i + 1) << " :exception " << ex.msg() << ")\n";);
+            }
+            catch (...) {
+                // an exception must not escape the thread
+                IF_VERBOSE(1, verbose_stream() << "(spacer.thread " << (i + 1) << " :exception)\n";);
+            }
+        });
+    }
+    auto stop = [&]() {
+        for (helper* h : helpers)
+            h->m.limit().cancel();
+        for (auto& th : threads)
+            th.join();
+        m_num_imported += main_exchange->num_imported();
+        m_context->callbacks().pop_back();
+    };
+
+    lbool r = l_undef;
+    try {
+        r = m_context->solve(from_lvl);
+    }
+    catch (...) {
+        stop();
+        throw;
+    }
+    stop();
+    IF_VERBOSE(1, verbose_stream() << "(spacer.threads :imported " << m_num_imported << ")\n";);
+    return r;
+}
+
+#endif
+
 lbool dl_interface::query_from_lvl(expr * query, unsigned lvl)
 {
     //we restore the initial state in the datalog context
@@ -257,7 +408,7 @@ lbool dl_interface::query_from_lvl(expr * query, unsigned lvl)
         return l_false;
     }
 
-    return m_context->solve(lvl);
+    return solve(lvl);
 
 }
 
@@ -304,11 +455,14 @@ unsigned dl_interface::get_num_levels(func_decl* pred)
 void dl_interface::collect_statistics(statistics& st) const
 {
     m_context->collect_statistics(st);
+    if (m_num_imported > 0)
+        st.update("SPACER num imported lemmas", m_num_imported);
 }
 
 void dl_interface::reset_statistics()
 {
     m_context->reset_statistics();
+    m_num_imported = 0;
 }
 
 void dl_interface::display_certificate(std::ostream& out) const
@@ -39,8 +39,10 @@ class dl_interface : public datalog::engine_base {
     context*          m_context;
     obj_map<func_decl, func_decl*> m_pred2slice;
     ast_ref_vector    m_refs;
+    unsigned          m_num_imported = 0;
 
     void check_reset();
+    lbool solve(unsigned from_lvl);
 
 public:
     dl_interface(datalog::context& ctx);
@@ -64,6 +64,7 @@ void lemma_bool_inductive_generalizer::operator()(lemma_ref &lemma) {
 
     m_st.count++;
     scoped_watch _w_(m_st.watch);
+    profiler::scope _p(m_ctx.get_profiler(), "generalize.bool_ind");
 
     unsigned uses_level;
     pred_transformer &pt = lemma->get_pob()->pt();
@@ -152,6 +153,7 @@ void unsat_core_generalizer::operator()(lemma_ref &lemma)
 {
     m_st.count++;
     scoped_watch _w_(m_st.watch);
+    profiler::scope _p(m_ctx.get_profiler(), "generalize.unsat_core");
     ast_manager &m = lemma->get_ast_manager();
 
     pred_transformer &pt = lemma->get_pob()->pt();
@@ -222,6 +224,7 @@ bool lemma_array_eq_generalizer::is_array_eq (ast_manager &m, expr* e) {
 
 void lemma_array_eq_generalizer::operator() (lemma_ref &lemma)
 {
+    profiler::scope _p(m_ctx.get_profiler(), "generalize.array_eq");
 
     ast_manager &m = lemma->get_ast_manager();
 
@@ -314,6 +317,7 @@ void lemma_eq_generalizer::operator() (lemma_ref &lemma) {
 
     if (lemma->get_cube().empty()) return;
 
+    profiler::scope _p(m_ctx.get_profiler(), "generalize.eq");
     ast_manager &m = m_ctx.get_ast_manager();
     mbp::term_graph egraph(m);
     egraph.add_lits(lemma->get_cube());
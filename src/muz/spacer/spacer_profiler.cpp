@@ -0,0 +1,103 @@
+/*++
+Copyright (c) 2020 Microsoft Corporation
+
+Module Name:
+
+    spacer_profiler.cpp
+
+Abstract:
+
+    Timed events of the phases of SPACER.
+
+Revision History:
+
+--*/
+
+#include <iomanip>
+#include "ast/ast.h"
+#include "muz/spacer/spacer_util.h"
+#include "muz/spacer/spacer_profiler.h"
+
+namespace spacer {
+
+double profiler::now() const {
+    return std::chrono::duration<double, std::micro>(clock::now() - m_origin).count();
+}
+
+void profiler::reset() {
+    m_events.reset();
+    m_open.reset();
+    m_origin = clock::now();
+}
+
+unsigned profiler::open(char const* name, func_decl* pred, bool has_level, unsigned level) {
+    event e;
+    e.m_name = name;
+    e.m_pred = pred ? pred->get_name() : symbol::null;
+    e.m_level = level;
+    e.m_has_level = has_level;
+    if (!m_open.empty()) {
+        event const& outer = m_events[m_open.back()];
+        if (!pred) e.m_pred = outer.m_pred;
+        if (!has_level) {
+            e.m_level = outer.m_level;
+            e.m_has_level = outer.m_has_level;
+        }
+    }
+    e.m_start = now();
+    e.m_duration = 0;
+    m_open.push_back(m_events.size());
+    m_events.push_back(e);
+    return m_events.size() - 1;
+}
+
+void profiler::close(unsigned idx) {
+    SASSERT(!m_open.empty() && m_open.back() == idx);
+    m_events[idx].m_duration = now() - m_events[idx].m_start;
+    m_open.pop_back();
+}
+
+static void display_json_string(std::ostream& out, std::string const& s) {
+    out << "\"";
+    for (char c : s) {
+        if (c == '"' || c == '\\')
+            out << '\\' << c;
+        else if (static_cast<unsigned char>(c) < 0x20)
+            out << "\\u" << std::hex << std::setw(4) << std::setfill('0')
+                << static_cast<unsigned>(c) << std::dec << std::setfill(' ');
+        else
+            out << c;
+    }
+    out << "\"";
+}
+
+std::ostream& profiler::display_chrome_trace(std::ostream& out) const {
+    out << "{\"traceEvents\":[";
+    bool first = true;
+    for (event const& e : m_events) {
+        if (!first) out << ",";
+        first = false;
+        out << "\n{\"name\":\"" << e.m_name << "\",\"cat\":\"spacer\",\"ph\":\"X\""
+            << ",\"ts\":" << std::fixed << std::setprecision(3) << e.m_start
+            << ",\"dur\":" << e.m_duration
+            << ",\"pid\":1,\"tid\":1,\"args\":{";
+        bool sep = false;
+        if (e.m_pred != symbol::null) {
+            out << "\"pred\":";
+            display_json_string(out, e.m_pred.str());
+            sep = true;
+        }
+        if (e.m_has_level) {
+            if (sep) out << ",";
+            if (is_infty_level(e.m_level))
+                out << "\"level\":\"oo\"";
+            else
+                out << "\"level\":" << e.m_level;
+        }
+        out << "}}";
+    }
+    out << "\n],\"displayTimeUnit\":\"ms\"}\n";
+    return out;
+}
+
+}
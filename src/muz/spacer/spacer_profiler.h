@@ -0,0 +1,83 @@
+/*++
+Copyright (c) 2020 Microsoft Corporation
+
+Module Name:
+
+    spacer_profiler.h
+
+Abstract:
+
+    Timed events of the phases of SPACER.
+
+    A scope records one event with the time at which it is entered and
+    how long it stays open. Events carry the predicate and the level
+    they work on; a scope that is opened without them takes them from
+    the innermost enclosing scope, so solver checks and interpolation
+    are attributed to the pob or lemma that caused them.
+
+    The events are written in the Chrome trace event format and can be
+    loaded into chrome://tracing or Perfetto.
+
+Revision History:
+
+--*/
+#pragma once
+
+#include <chrono>
+#include <iostream>
+#include "util/symbol.h"
+#include "util/vector.h"
+
+class func_decl;
+
+namespace spacer {
+
+class profiler {
+    typedef std::chrono::steady_clock clock;
+
+    struct event {
+        char const* m_name;
+        symbol      m_pred;
+        unsigned    m_level;
+        bool        m_has_level;
+        double      m_start;     // microseconds since the profiler was created
+        double      m_duration;
+    };
+
+    bool              m_enabled;
+    clock::time_point m_origin;
+    vector<event>     m_events;
+    unsigned_vector   m_open;    // events of the scopes that are open
+
+    double now() const;
+    unsigned open(char const* name, func_decl* pred, bool has_level, unsigned level);
+    void close(unsigned idx);
+
+public:
+    profiler(): m_enabled(false), m_origin(clock::now()) {}
+
+    bool enabled() const { return m_enabled; }
+    void set_enabled(bool f) { m_enabled = f; }
+    void reset();
+
+    /**
+       \brief Record an event for the lifetime of the scope if the
+       profiler is enabled.
+    */
+    class scope {
+        profiler* m_profiler;
+        unsigned  m_idx;
+    public:
+        scope(profiler* p, char const* name, func_decl* pred = nullptr):
+            m_profiler(p && p->enabled() ? p : nullptr),
+            m_idx(m_profiler ? m_profiler->open(name, pred, false, 0) : 0) {}
+        scope(profiler* p, char const* name, func_decl* pred, unsigned level):
+            m_profiler(p && p->enabled() ? p : nullptr),
+            m_idx(m_profiler ? m_profiler->open(name, pred, true, level) : 0) {}
+        ~scope() { if (m_profiler) m_profiler->close(m_idx); }
+    };
+
+    std::ostream& display_chrome_trace(std::ostream& out) const;
+};
+
+}
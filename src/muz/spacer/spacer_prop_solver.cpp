@@ -305,7 +305,11 @@ lbool prop_solver::internal_check_assumptions(expr_ref_vector &hard_atoms,
     }
 
     if (m_in_level) { assert_level_atoms(m_current_level); }
-    lbool result = maxsmt(hard_atoms, soft_atoms, clauses);
+    lbool result;
+    {
+        profiler::scope _p(m_profiler, "check");
+        result = maxsmt(hard_atoms, soft_atoms, clauses);
+    }
     if (result != l_false && m_model) { m_ctx->get_model(*m_model); }
 
     SASSERT(result != l_false || soft_atoms.empty());
@@ -334,6 +338,7 @@ lbool prop_solver::internal_check_assumptions(expr_ref_vector &hard_atoms,
     if (result == l_false && m_core && m.proofs_enabled() && !m_subset_based_core) {
         TRACE("spacer", tout << "Using IUC core\n";);
         m_core->reset();
+        profiler::scope _p(m_profiler, "iuc");
         m_ctx->get_iuc(*m_core);
     } else if (result == l_false && m_core) {
         m_core->reset();
@@ -31,6 +31,7 @@ Revision History:
 #include "solver/solver.h"
 #include "muz/spacer/spacer_iuc_solver.h"
 #include "muz/spacer/spacer_util.h"
+#include "muz/spacer/spacer_profiler.h"
 
 struct fp_params;
 
@@ -61,6 +62,7 @@ private:
     unsigned            m_current_level;    // set when m_in_level
 
     random_gen          m_random;
+    profiler*           m_profiler = nullptr;
 
     void assert_level_atoms(unsigned level);
 
@@ -79,6 +81,8 @@ public:
     prop_solver(ast_manager &m, solver *solver0, solver* solver1,
                 fp_params const& p, symbol const& name);
 
+    void set_profiler(profiler* p) { m_profiler = p; }
+
 
     void set_core(expr_ref_vector* core) { m_core = core; }
     void set_model(model_ref* mdl) { m_model = mdl; }
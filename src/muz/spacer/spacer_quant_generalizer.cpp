@@ -685,6 +685,7 @@ void lemma_quantifier_generalizer::operator()(lemma_ref &lemma) {
 
     m_st.count++;
     scoped_watch _w_(m_st.watch);
+    profiler::scope _p(m_ctx.get_profiler(), "generalize.quant");
 
     TRACE("spacer_qgen",
           tout << "initial cube: " << mk_and(lemma->get_cube()) << "\n";);
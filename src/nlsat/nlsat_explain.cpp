@@ -21,6 +21,10 @@ Revision History:
 #include "nlsat/nlsat_evaluator.h"
 #include "math/polynomial/algebraic_numbers.h"
 #include "util/ref_buffer.h"
+#include "util/scoped_ptr_vector.h"
+#ifndef SINGLE_THREAD
+#include <thread>
+#endif
 
 namespace nlsat {
 
@@ -45,6 +49,7 @@ namespace nlsat {
         bool                    m_minimize_cores;
         bool                    m_factor;
         bool                    m_signed_project;
+        unsigned                m_psc_threads;
 
         struct todo_set {
             polynomial::cache  &    m_cache;
@@ -152,6 +157,7 @@ namespace nlsat {
             m_full_dimensional = false;
             m_minimize_cores   = false;
             m_signed_project   = false;
+            m_psc_threads      = 1;
         }
         
         ~imp() {
@@ -672,6 +678,103 @@ namespace nlsat {
             }
         }
         
+        /**
+           \brief Polynomial manager owned by one thread of prefetch_psc_chains.
+        */
+        struct psc_worker {
+            reslimit              m_limit;
+            unsynch_mpz_manager   m_nm;
+            pmanager              m_pm;
+            polynomial_ref_vector m_ps;
+            polynomial_ref_vector m_qs;
+            polynomial_ref_vector m_results;
+            unsigned_vector       m_starts;
+            bool                  m_failed = false;
+            psc_worker(): m_pm(m_limit, m_nm), m_ps(m_pm), m_qs(m_pm), m_results(m_pm) {}
+
+            void operator()(var x) {
+                try {
+                    polynomial_ref_vector S(m_pm);
+                    for (unsigned i = 0; i < m_ps.size(); i++) {
+                        m_pm.psc_chain(m_ps.get(i), m_qs.get(i), x, S);
+                        m_starts.push_back(m_results.size());
+                        for (unsigned j = 0; j < S.size(); j++)
+                            m_results.push_back(S.get(j));
+                    }
+                    m_starts.push_back(m_results.size());
+                }
+                catch (z3_exception &) {
+                    m_failed = true;
+                }
+            }
+        };
+
+        /**
+           \brief Rough cost of computing the psc chain of p and q with respect to x.
+        */
+        static unsigned psc_work(poly const * p, poly const * q, var x) {
+            return pmanager::degree(p, x) * pmanager::degree(q, x) * (pmanager::size(p) + pmanager::size(q));
+        }
+
+        static const unsigned psc_parallel_min_work = 256;
+
+        /**
+           \brief Compute the psc chains of the pairs (ps[i], qs[i]) that are not
+           yet cached, using up to m_psc_threads threads, and store them in m_cache.
+
+           Each thread works on copies of its pairs in a private polynomial manager.
+           The results are copied back and cached in pair order, so the
+           sequential pass in psc() finds them and produces the same lemmas.
+
+           Starting threads and copying the pairs costs more than the chains of
+           small polynomials, so nothing is done when the total work of the pairs
+           is below psc_parallel_min_work.
+        */
+        void prefetch_psc_chains(polynomial_ref_vector const & ps, polynomial_ref_vector const & qs, var x) {
+#ifndef SINGLE_THREAD
+            if (m_psc_threads <= 1)
+                return;
+            unsigned_vector todo;
+            unsigned work = 0;
+            for (unsigned i = 0; i < ps.size(); i++) {
+                if (!m_cache.contains_psc_chain(ps.get(i), qs.get(i), x)) {
+                    todo.push_back(i);
+                    work += psc_work(ps.get(i), qs.get(i), x);
+                }
+            }
+            if (todo.size() < 2 || work < psc_parallel_min_work)
+                return;
+            unsigned num_threads = std::min(m_psc_threads, todo.size());
+            scoped_ptr_vector<psc_worker> workers;
+            scoped_limits sl(m_pm.limit());
+            for (unsigned w = 0; w < num_threads; w++) {
+                workers.push_back(alloc(psc_worker));
+                sl.push_child(&workers[w]->m_limit);
+            }
+            for (unsigned k = 0; k < todo.size(); k++) {
+                psc_worker & w = *workers[k % num_threads];
+                w.m_ps.push_back(convert(m_pm, ps.get(todo[k]), w.m_pm));
+                w.m_qs.push_back(convert(m_pm, qs.get(todo[k]), w.m_pm));
+            }
+            vector<std::thread> threads(num_threads);
+            for (unsigned w = 0; w < num_threads; w++)
+                threads[w] = std::thread([&, w]() { (*workers[w])(x); });
+            for (auto & th : threads)
+                th.join();
+            polynomial_ref_vector S(m_pm);
+            for (unsigned k = 0; k < todo.size(); k++) {
+                psc_worker & w = *workers[k % num_threads];
+                if (w.m_failed)
+                    continue;
+                unsigned j = k / num_threads;
+                S.reset();
+                for (unsigned r = w.m_starts[j]; r < w.m_starts[j + 1]; r++)
+                    S.push_back(convert(w.m_pm, w.m_results.get(r), m_pm));
+                m_cache.set_psc_chain(ps.get(todo[k]), qs.get(todo[k]), x, S);
+            }
+#endif
+        }
+
         /**
            \brief For each p in ps, add v-psc(x, p, p') into m_todo
 
@@ -684,6 +787,17 @@ namespace nlsat {
             polynomial_ref p(m_pm);
             polynomial_ref p_prime(m_pm);
             unsigned sz = ps.size();
+            if (m_psc_threads > 1) {
+                polynomial_ref_vector qs(m_pm), q_primes(m_pm);
+                for (unsigned i = 0; i < sz; i++) {
+                    p = ps.get(i);
+                    if (degree(p, x) < 2)
+                        continue;
+                    qs.push_back(p);
+                    q_primes.push_back(derivative(p, x));
+                }
+                prefetch_psc_chains(qs, q_primes, x);
+            }
             for (unsigned i = 0; i < sz; i++) {
                 p = ps.get(i);
                 if (degree(p, x) < 2)
@@ -705,6 +819,16 @@ namespace nlsat {
             polynomial_ref p(m_pm);
             polynomial_ref q(m_pm);
             unsigned sz = ps.size();
+            if (m_psc_threads > 1) {
+                polynomial_ref_vector lhs(m_pm), rhs(m_pm);
+                for (unsigned i = 0; i + 1 < sz; i++) {
+                    for (unsigned j = i + 1; j < sz; j++) {
+                        lhs.push_back(ps.get(i));
+                        rhs.push_back(ps.get(j));
+                    }
+                }
+                prefetch_psc_chains(lhs, rhs, x);
+            }
             for (unsigned i = 0; i < sz - 1; i++) {
                 p = ps.get(i);
                 for (unsigned j = i + 1; j < sz; j++) {
@@ -1864,6 +1988,10 @@ namespace nlsat {
         m_imp->m_signed_project = f;
     }
 
+    void explain::set_psc_threads(unsigned n) {
+        m_imp->m_psc_threads = n;
+    }
+
     void explain::operator()(unsigned n, literal const * ls, scoped_literal_vector & result) {
         (*m_imp)(n, ls, result);
     }
@@ -276,6 +276,8 @@ namespace nlsat {
             m_explain.set_simplify_cores(m_simplify_cores);
             m_explain.set_minimize_cores(min_cores);
             m_explain.set_factor(p.factor());
+            m_explain.set_psc_threads(p.psc_threads());
+            m_cache.set_max_entries(p.projection_cache_size());
             m_am.updt_params(p.p);
         }
 
@@ -2228,6 +2230,7 @@ namespace nlsat {
             st.update("nlsat decisions", m_decisions);
             st.update("nlsat stages", m_stages);
             st.update("nlsat irrational assignments", m_irrational_assignments);
+            m_cache.collect_statistics(st);
         }
 
         void reset_statistics() {
@@ -2236,6 +2239,7 @@ namespace nlsat {
             m_decisions              = 0;
             m_stages                 = 0;
             m_irrational_assignments = 0;
+            m_cache.reset_statistics();
         }
 
         // -----------------------
@@ -33,7 +33,8 @@ namespace q {
         m_new_gen_function(m),
         m_parser(m),
         m_evaluator(m),
-        m_subst(m)
+        m_subst(m),
+        m_instance_cache(m)
     {
         init_parser_vars();
         m_vals.resize(15, 0.0f);
@@ -51,6 +52,7 @@ namespace q {
             VERIFY(m_parser.parse_string("cost", m_new_gen_function));
         }
         m_eager_cost_threshold = m_params.m_qi_eager_threshold;
+        m_instance_cache.set_max_size(m_params.m_qi_instance_cache_size);
     }
 
     void queue::init_parser_vars() {
@@ -149,11 +151,25 @@ namespace q {
         if (em.propagate(true, f.nodes(), gen, *f.c, new_propagation))
             return;
 
-        auto* ebindings = m_subst(q, num_bindings);
-        for (unsigned i = 0; i < num_bindings; ++i)
-            ebindings[i] = f.nodes()[i]->get_expr();
-        expr_ref instance = m_subst();
-        ctx.get_rewriter()(instance);
+        expr_ref instance(m);
+        expr* cached = nullptr;
+        if (m_params.m_qi_instance_cache) {
+            m_cache_bindings.reset();
+            for (unsigned i = 0; i < num_bindings; ++i)
+                m_cache_bindings.push_back(f.nodes()[i]->get_expr());
+            cached = m_instance_cache.find(q, num_bindings, m_cache_bindings.data());
+        }
+        if (cached) 
+            instance = cached;
+        else {
+            auto* ebindings = m_subst(q, num_bindings);
+            for (unsigned i = 0; i < num_bindings; ++i)
+                ebindings[i] = f.nodes()[i]->get_expr();
+            instance = m_subst();
+            ctx.get_rewriter()(instance);
+            if (m_params.m_qi_instance_cache)
+                m_instance_cache.insert(q, num_bindings, m_cache_bindings.data(), instance);
+        }
         if (m.is_true(instance)) {
             stat->inc_num_instances_simplify_true();
             return;
@@ -252,6 +268,8 @@ namespace q {
         st.update("q missed instantiations", m_delayed_entries.size());
         st.update("q min missed cost", fmin);
         st.update("q max missed cost", fmax);
+        if (m_params.m_qi_instance_cache)
+            m_instance_cache.collect_statistics(st);
     }
 
 }
@@ -18,6 +18,7 @@ Author:
 
 #include "ast/quantifier_stat.h"
 #include "ast/cost_evaluator.h"
+#include "ast/quantifier_instance_cache.h"
 #include "ast/rewriter/cached_var_subst.h"
 #include "parsers/util/cost_parser.h"
 #include "sat/smt/q_fingerprint.h"
@@ -50,6 +51,8 @@ namespace q {
         cost_parser                   m_parser;
         cost_evaluator                m_evaluator;
         cached_var_subst              m_subst;
+        instance_cache                m_instance_cache;
+        ptr_vector<expr>              m_cache_bindings;
         svector<float>                m_vals;
         double                        m_eager_cost_threshold { 0 };
         struct entry {
@@ -42,6 +42,8 @@ struct qi_params {
     unsigned           m_qi_max_instances;
     bool               m_qi_lazy_instantiation;
     bool               m_qi_conservative_final_check;
+    bool               m_qi_instance_cache;
+    unsigned           m_qi_instance_cache_size;
 
     bool               m_mbqi;
     unsigned           m_mbqi_max_cexs;
@@ -50,6 +52,7 @@ struct qi_params {
     bool               m_mbqi_trace;
     unsigned           m_mbqi_force_template;
     const char *       m_mbqi_id;
+    unsigned           m_mbqi_threads;
 
     qi_params(params_ref const & p = params_ref()):
         /*
@@ -91,13 +94,16 @@ struct qi_params {
         m_qi_max_instances(UINT_MAX),
         m_qi_lazy_instantiation(false),
         m_qi_conservative_final_check(false),
+        m_qi_instance_cache(false),
+        m_qi_instance_cache_size(1000000),
         m_mbqi(true), // enabled by default
         m_mbqi_max_cexs(1),
         m_mbqi_max_cexs_incr(1),
         m_mbqi_max_iterations(1000),
         m_mbqi_trace(false),
         m_mbqi_force_template(10),
-        m_mbqi_id(nullptr)
+        m_mbqi_id(nullptr),
+        m_mbqi_threads(1)
     {
         updt_params(p);
     }
@@ -37,6 +37,7 @@ namespace smt {
         m_parser(m),
         m_evaluator(m),
         m_subst(m),
+        m_instance_cache(m),
         m_instances(m) {
         init_parser_vars();
         m_vals.resize(15, 0.0f);
@@ -63,6 +64,7 @@ namespace smt {
             VERIFY(m_parser.parse_string("cost", m_new_gen_function));
         }
         m_eager_cost_threshold = m_params.m_qi_eager_threshold;
+        m_instance_cache.set_max_size(m_params.m_qi_instance_cache_size);
     }
 
     void qi_queue::init_parser_vars() {
@@ -221,16 +223,36 @@ namespace smt {
 
         STRACE("instance", tout << "### " << static_cast<void*>(f) <<", " << q->get_qid()  << "\n";);
 
-        auto* ebindings = m_subst(q, num_bindings);
-        for (unsigned i = 0; i < num_bindings; ++i)
-            ebindings[i] = bindings[i]->get_expr();
-        expr_ref instance = m_subst();
+        // the instance cache does not record the rewriting proofs.
+        bool use_cache = m_params.m_qi_instance_cache && !m.proofs_enabled();
+        expr * cached  = nullptr;
+        if (use_cache) {
+            m_cache_bindings.reset();
+            for (unsigned i = 0; i < num_bindings; ++i)
+                m_cache_bindings.push_back(bindings[i]->get_expr());
+            cached = m_instance_cache.find(q, num_bindings, m_cache_bindings.data());
+        }
 
-        TRACE("qi_queue", tout << "new instance:\n" << mk_pp(instance, m) << "\n";);
-        TRACE("qi_queue_instance", tout << "new instance:\n" << mk_pp(instance, m) << "\n";);
+        expr_ref  instance(m);
         expr_ref  s_instance(m);
         proof_ref pr(m);
-        m_context.get_rewriter()(instance, s_instance, pr);
+        if (cached) {
+            TRACE("qi_queue", tout << "cached instance:\n" << mk_pp(cached, m) << "\n";);
+            instance   = cached;
+            s_instance = cached;
+        }
+        else {
+            auto* ebindings = m_subst(q, num_bindings);
+            for (unsigned i = 0; i < num_bindings; ++i)
+                ebindings[i] = bindings[i]->get_expr();
+            instance = m_subst();
+
+            TRACE("qi_queue", tout << "new instance:\n" << mk_pp(instance, m) << "\n";);
+            TRACE("qi_queue_instance", tout << "new instance:\n" << mk_pp(instance, m) << "\n";);
+            m_context.get_rewriter()(instance, s_instance, pr);
+            if (use_cache)
+                m_instance_cache.insert(q, num_bindings, m_cache_bindings.data(), s_instance);
+        }
         TRACE("qi_queue_bug", tout << "new instance after simplification:\n" << s_instance << "\n";);
         if (m.is_true(s_instance)) {
             TRACE("checker", tout << "reduced to true, before:\n" << mk_ll_pp(instance, m););
@@ -479,6 +501,8 @@ namespace smt {
         get_min_max_costs(min, max);
         st.update("min missed qa cost", min);
         st.update("max missed qa cost", max);
+        if (m_params.m_qi_instance_cache)
+            m_instance_cache.collect_statistics(st);
 #if 0
         if (m_params.m_qi_profile) {
             out << "missed/delayed quantifier instances:\n";
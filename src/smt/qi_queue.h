@@ -20,6 +20,7 @@ Revision History:
 
 #include "ast/ast.h"
 #include "ast/quantifier_stat.h"
+#include "ast/quantifier_instance_cache.h"
 #include "ast/rewriter/cached_var_subst.h"
 #include "parsers/util/cost_parser.h"
 #include "smt/smt_checker.h"
@@ -50,6 +51,8 @@ namespace smt {
         cost_parser                   m_parser;
         cost_evaluator                m_evaluator;
         cached_var_subst              m_subst;
+        q::instance_cache             m_instance_cache;
+        ptr_vector<expr>              m_cache_bindings;
         svector<float>                m_vals;
         double                        m_eager_cost_threshold;
         struct entry {
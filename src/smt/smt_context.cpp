@@ -206,7 +206,11 @@ namespace smt {
     }
 
     context * context::mk_fresh(symbol const * l, smt_params * p, params_ref const& pa) {
-        context * new_ctx = alloc(context, m, p ? *p : m_fparams, pa);
+        return mk_fresh(m, l, p, pa);
+    }
+
+    context * context::mk_fresh(ast_manager & dst_m, symbol const * l, smt_params * p, params_ref const& pa) {
+        context * new_ctx = alloc(context, dst_m, p ? *p : m_fparams, pa);
         new_ctx->m_is_auxiliary = true;
         new_ctx->set_logic(l == nullptr ? m_setup.get_logic() : *l);
         copy_plugins(*this, *new_ctx);
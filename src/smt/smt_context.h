@@ -1590,6 +1590,11 @@ namespace smt {
         */
         context * mk_fresh(symbol const * l = nullptr,  smt_params * smtp = nullptr, params_ref const & p = params_ref());
 
+        /**
+           \brief Return a new context like mk_fresh, but over dst_m, which is a copy of the manager of this context.
+        */
+        context * mk_fresh(ast_manager & dst_m, symbol const * l, smt_params * smtp, params_ref const & p);
+
         static void copy(context& src, context& dst, bool override_base = false);
 
         /**
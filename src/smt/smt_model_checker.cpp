@@ -29,11 +29,16 @@ Revision History:
 #include "ast/ast_pp.h"
 #include "ast/array_decl_plugin.h"
 #include "ast/ast_smt2_pp.h"
+#include "ast/ast_translation.h"
 #include "smt/smt_model_checker.h"
 #include "smt/smt_context.h"
 #include "smt/smt_model_finder.h"
 #include "model/model_pp.h"
 #include <tuple>
+#ifndef SINGLE_THREAD
+#include <atomic>
+#include <thread>
+#endif
 
 namespace smt {
 
@@ -55,6 +60,7 @@ namespace smt {
     model_checker::~model_checker() {
         m_aux_context = nullptr; // delete aux context before fparams
         m_fparams = nullptr;
+        reset_aux_pool();
     }
 
     quantifier * model_checker::get_flat_quantifier(quantifier * q) {
@@ -140,29 +146,28 @@ namespace smt {
     }
 
     /**
-       \brief Assert in m_aux_context, the constraint
+       \brief Add to fmls the constraint
 
          sk = e_1 OR ... OR sk = e_n
 
          where {e_1, ..., e_n} is the universe.
      */
-    void model_checker::restrict_to_universe(expr * sk, obj_hashtable<expr> const & universe) {
+    void model_checker::restrict_to_universe(expr * sk, obj_hashtable<expr> const & universe, expr_ref_vector & fmls) {
         SASSERT(!universe.empty());
         ptr_buffer<expr> eqs;
         for (expr * e : universe) {
             eqs.push_back(m.mk_eq(sk, e));
         }
-        expr_ref fml(m.mk_or(eqs.size(), eqs.data()), m);
-        m_aux_context->assert_expr(fml);
+        fmls.push_back(m.mk_or(eqs.size(), eqs.data()));
     }
 
     /**
-       \brief Assert the negation of q after applying the interpretation in m_curr_model to the uninterpreted symbols in q.
+       \brief Store in fmls the negation of q after applying the interpretation in m_curr_model
+       to the uninterpreted symbols in q.
 
        The variables are replaced by skolem constants. These constants are stored in sks.
     */
-
-    bool model_checker::assert_neg_q_m(quantifier * q, expr_ref_vector & sks) {
+    bool model_checker::mk_neg_q_m(quantifier * q, expr_ref_vector & sks, expr_ref_vector & fmls) {
         expr_ref tmp(m);
         
         TRACE("model_checker", tout << "curr_model:\n"; model_pp(tout, *m_curr_model););
@@ -181,7 +186,7 @@ namespace smt {
             sks[num_decls - i - 1]        = sk;
             subst_args[num_decls - i - 1] = sk;
             if (m_curr_model->is_finite(s)) {
-                restrict_to_universe(sk, m_curr_model->get_known_universe(s));
+                restrict_to_universe(sk, m_curr_model->get_known_universe(s), fmls);
             }
         }
 
@@ -190,7 +195,7 @@ namespace smt {
         expr_ref r(m);
         r = m.mk_not(sk_body);
         TRACE("model_checker", tout << "mk_neg_q_m:\n" << mk_ismt2_pp(r, m) << "\n";);
-        m_aux_context->assert_expr(r);
+        fmls.push_back(r);
         return true;
     }
 
@@ -334,28 +339,38 @@ namespace smt {
     */
 
     bool model_checker::check(quantifier * q) {
-        SASSERT(!m_aux_context->relevancy());
-        scoped_ctx_push _push(m_aux_context.get());
-
         quantifier * flat_q = get_flat_quantifier(q);
         TRACE("model_checker", tout << "model checking:\n" << expr_ref(flat_q->get_expr(), m) << "\n";);
-        expr_ref_vector sks(m);
-
-        if (!assert_neg_q_m(flat_q, sks))
+        expr_ref_vector sks(m), fmls(m);
+        if (!mk_neg_q_m(flat_q, sks, fmls))
             return false;
+        return check(q, sks, fmls, nullptr);
+    }
+
+    /**
+       \brief Check q using the negation fmls produced by mk_neg_q_m.
+       If complete_cex is not null, it is a model of fmls and the complete check is skipped.
+    */
+    bool model_checker::check(quantifier * q, expr_ref_vector & sks, expr_ref_vector const & fmls, model * complete_cex_ptr) {
+        SASSERT(!m_aux_context->relevancy());
+        scoped_ctx_push _push(m_aux_context.get());
+
+        for (expr * fml : fmls)
+            m_aux_context->assert_expr(fml);
         TRACE("model_checker", tout << "skolems:\n" << sks << "\n";);
 
-        flet<bool> l(m_aux_context->get_fparams().m_array_fake_support, true);
-        lbool r = m_aux_context->check();
+        model_ref complete_cex = complete_cex_ptr;
+        if (!complete_cex) {
+            flet<bool> l(m_aux_context->get_fparams().m_array_fake_support, true);
+            lbool r = m_aux_context->check();
         
-        TRACE("model_checker", tout << "[complete] model-checker result: " << to_sat_str(r) << "\n";);
-        if (r != l_true) {
-            return r == l_false; // quantifier is satisfied by m_curr_model
+            TRACE("model_checker", tout << "[complete] model-checker result: " << to_sat_str(r) << "\n";);
+            if (r != l_true) {
+                return r == l_false; // quantifier is satisfied by m_curr_model
+            }
+            m_aux_context->get_model(complete_cex);
         }
 
-        model_ref complete_cex;
-        m_aux_context->get_model(complete_cex);
-
         // try to find new instances using instantiation sets.
         m_model_finder.restrict_sks_to_inst_set(m_aux_context.get(), q, sks);
 
@@ -405,6 +420,112 @@ namespace smt {
         }
     }
 
+    void model_checker::init_aux_pool(unsigned num_threads) {
+        while (m_pool_contexts.size() < num_threads) {
+            smt_params * fp = alloc(smt_params, *m_fparams);
+            fp->m_array_fake_support = true;
+            m_pool_fparams.push_back(fp);
+            ast_manager * pm = alloc(ast_manager, m, true);
+            m_pool_managers.push_back(pm);
+            symbol logic;
+            params_ref p;
+            p.set_bool("arith.dump_lemmas", false);
+            m_pool_contexts.push_back(m_context->mk_fresh(*pm, &logic, fp, p));
+        }
+    }
+
+    void model_checker::reset_aux_pool() {
+        // contexts are deleted before their managers and parameters
+        m_pool_contexts.reset();
+        m_pool_managers.reset();
+        m_pool_fparams.reset();
+    }
+
+    /**
+       \brief Check the quantifiers in qs against m_curr_model using the pool of auxiliary contexts.
+
+       results[i] records the negation of qs[i] that was checked, and whether the
+       model satisfies qs[i] (l_false) or not (l_true). For the latter, the counterexample
+       found by the worker is kept so that check does not repeat the complete check.
+       Quantifiers are assigned to workers statically so the outcome does not
+       depend on thread scheduling.
+    */
+    void model_checker::check_parallel(ptr_vector<quantifier> const & qs, scoped_ptr_vector<pool_result> & results) {
+#ifndef SINGLE_THREAD
+        unsigned num_threads = std::min(m_params.m_mbqi_threads, qs.size());
+        init_aux_pool(num_threads);
+
+        // negations of the quantifiers are created and translated sequentially,
+        // since they are built from m_curr_model over the main manager.
+        // Each worker has one translation, so shared subterms are translated once.
+        scoped_ptr_vector<ast_translation> to_pool;
+        for (unsigned w = 0; w < num_threads; ++w)
+            to_pool.push_back(alloc(ast_translation, m, *m_pool_managers[w]));
+        vector<expr_ref_vector> pfmls;
+        for (unsigned i = 0; i < qs.size(); ++i) {
+            unsigned w = i % num_threads;
+            pool_result * res = alloc(pool_result, m);
+            results.push_back(res);
+            pfmls.push_back(expr_ref_vector(*m_pool_managers[w]));
+            if (!mk_neg_q_m(get_flat_quantifier(qs[i]), res->m_sks, res->m_fmls))
+                continue;
+            for (expr * fml : res->m_fmls)
+                pfmls.back().push_back((*to_pool[w])(fml));
+        }
+
+        scoped_limits sl(m.limit());
+        for (unsigned i = 0; i < num_threads; ++i)
+            sl.push_child(&(m_pool_managers[i]->limit()));
+
+        vector<model_ref> pcexs(qs.size());
+        svector<lbool> presults(qs.size(), l_undef);
+        std::atomic<bool> failed(false);
+        auto worker_thread = [&](unsigned w) {
+            context & ctx = *m_pool_contexts[w];
+            try {
+                for (unsigned i = w; i < qs.size(); i += num_threads) {
+                    if (pfmls[i].empty())
+                        continue;
+                    ctx.push();
+                    for (expr * fml : pfmls[i])
+                        ctx.assert_expr(fml);
+                    lbool r = ctx.check();
+                    if (r == l_true)
+                        ctx.get_model(pcexs[i]);
+                    ctx.pop(1);
+                    presults[i] = r;
+                }
+            }
+            catch (...) {
+                // remaining quantifiers are checked sequentially.
+                failed = true;
+            }
+        };
+
+        vector<std::thread> threads(num_threads);
+        for (unsigned i = 0; i < num_threads; ++i)
+            threads[i] = std::thread([&, i]() { worker_thread(i); });
+        for (auto & th : threads)
+            th.join();
+
+        scoped_ptr_vector<ast_translation> from_pool;
+        for (unsigned w = 0; w < num_threads; ++w)
+            from_pool.push_back(alloc(ast_translation, *m_pool_managers[w], m));
+        for (unsigned i = 0; i < qs.size(); ++i) {
+            results[i]->m_result = presults[i];
+            if (pcexs[i])
+                results[i]->m_cex = pcexs[i]->translate(*from_pool[i % num_threads]);
+        }
+        pcexs.reset();
+        pfmls.reset();
+
+        if (failed)
+            reset_aux_pool(); // an interrupted worker may be left with a pending scope
+        TRACE("model_checker", tout << "parallel check of " << qs.size() << " quantifiers, satisfied: "
+              << std::count(presults.begin(), presults.end(), l_false) << "\n";);
+#endif
+    }
+
     bool model_checker::check(proto_model * md, obj_map<enode, app *> const & root2value) {
         SASSERT(md != nullptr);
 
@@ -482,6 +603,7 @@ namespace smt {
     //
 
     void model_checker::check_quantifiers(bool& found_relevant, unsigned& num_failures) {
+        ptr_vector<quantifier> qs;
         for (quantifier * q : *m_qm) {
             if (!(m_qm->mbqi_enabled(q) &&
                   m_context->is_relevant(q) &&
@@ -489,7 +611,15 @@ namespace smt {
                   (!m_context->get_fparams().m_ematching || !m.is_lambda_def(q)))) {
                 continue;
             }
+            qs.push_back(q);
+        }
 
+        scoped_ptr_vector<pool_result> presults;
+        if (m_params.m_mbqi_threads > 1 && qs.size() > 1 && !m.has_trace_stream())
+            check_parallel(qs, presults);
+
+        for (unsigned i = 0; i < qs.size(); ++i) {
+            quantifier * q = qs[i];
             TRACE("model_checker",
                   tout << "Check: " << mk_pp(q, m) << "\n";
                   tout << m_context->get_assignment(q) << "\n";);
@@ -498,7 +628,14 @@ namespace smt {
                 verbose_stream() << "(smt.mbqi :checking " << q->get_qid() << ")\n";
             }
             found_relevant = true;
-            if (!check(q)) {
+            bool satisfied;
+            if (i >= presults.size() || presults[i]->m_result == l_undef)
+                satisfied = check(q);
+            else if (presults[i]->m_result == l_false)
+                satisfied = true; // satisfied by m_curr_model according to the parallel check.
+            else
+                satisfied = check(q, presults[i]->m_sks, presults[i]->m_fmls, presults[i]->m_cex.get());
+            if (!satisfied) {
                 if (m_params.m_mbqi_trace || get_verbosity_level() >= 5) {
                     IF_VERBOSE(0, verbose_stream() << "(smt.mbqi :failed " << q->get_qid() << ")\n");
                 }
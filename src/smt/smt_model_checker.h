@@ -21,9 +21,11 @@ Revision History:
 #pragma once
 
 #include "util/obj_hashtable.h"
+#include "util/scoped_ptr_vector.h"
 #include "ast/ast.h"
 #include "ast/array_decl_plugin.h"
 #include "ast/normal_forms/defined_names.h"
+#include "model/model.h"
 #include "smt/params/qi_params.h"
 #include "smt/params/smt_params.h"
 
@@ -48,6 +50,10 @@ namespace smt {
         obj_map<enode, app *> const *               m_root2value; // temp field to store mapping received in the check method.
         model_finder &                              m_model_finder;
         scoped_ptr<context>                         m_aux_context; // Auxiliary context used for model checking quantifiers.
+        // Pool of auxiliary contexts, each with its own ast_manager, used to check quantifiers concurrently.
+        scoped_ptr_vector<smt_params>               m_pool_fparams;
+        scoped_ptr_vector<ast_manager>              m_pool_managers;
+        scoped_ptr_vector<context>                  m_pool_contexts;
         unsigned                                    m_max_cexs;
         unsigned                                    m_iteration_idx;
         proto_model *                               m_curr_model;
@@ -57,14 +63,30 @@ namespace smt {
         friend class model_instantiation_set;
 
         void init_aux_context();
+        void init_aux_pool(unsigned num_threads);
+        void reset_aux_pool();
         void init_value2expr();
         expr * get_term_from_ctx(expr * val);
         expr * get_type_compatible_term(expr * val);
         expr_ref replace_value_from_ctx(expr * e);
-        void restrict_to_universe(expr * sk, obj_hashtable<expr> const & universe);
-        bool assert_neg_q_m(quantifier * q, expr_ref_vector & sks);
+        void restrict_to_universe(expr * sk, obj_hashtable<expr> const & universe, expr_ref_vector & fmls);
+        bool mk_neg_q_m(quantifier * q, expr_ref_vector & sks, expr_ref_vector & fmls);
         bool add_blocking_clause(model * cex, expr_ref_vector & sks);
         bool check(quantifier * q);
+        bool check(quantifier * q, expr_ref_vector & sks, expr_ref_vector const & fmls, model * complete_cex);
+
+        /**
+           \brief Result of checking the negation of a quantifier in the pool of auxiliary contexts.
+           m_cex is the counterexample of the complete check, translated back to m.
+        */
+        struct pool_result {
+            lbool           m_result { l_undef };
+            expr_ref_vector m_sks;
+            expr_ref_vector m_fmls;
+            model_ref       m_cex;
+            pool_result(ast_manager & m): m_sks(m), m_fmls(m) {}
+        };
+        void check_parallel(ptr_vector<quantifier> const & qs, scoped_ptr_vector<pool_result> & results);
         void check_quantifiers(bool& found_relevant, unsigned& num_failures);
 
         struct instance {
@@ -283,6 +283,7 @@ class theory_lra::imp {
             m_nla->settings().horner_subs_fixed() =           prms.arith_nl_horner_subs_fixed();            
             m_nla->settings().horner_frequency() =            prms.arith_nl_horner_frequency();
             m_nla->settings().horner_row_length_limit() =     prms.arith_nl_horner_row_length_limit();
+            m_nla->settings().horner_fp_filter() =            prms.arith_nl_horner_fp_filter();
             m_nla->settings().run_grobner() =                 prms.arith_nl_grobner();
             m_nla->settings().run_nra()  =                    prms.arith_nl_nra();
             m_nla->settings().grobner_subs_fixed() =          prms.arith_nl_grobner_subs_fixed();
@@ -293,6 +294,7 @@ class theory_lra::imp {
             m_nla->settings().grobner_number_of_conflicts_to_report() = prms.arith_nl_grobner_cnfl_to_report();
             m_nla->settings().grobner_quota() =               prms.arith_nl_gr_q();
             m_nla->settings().grobner_frequency() =           prms.arith_nl_grobner_frequency();
+            m_nla->settings().grobner_threads() =             prms.arith_nl_grobner_threads();
             m_nla->settings().expensive_patching()  =         prms.arith_nl_expp();
         }
     }
@@ -628,6 +628,46 @@ static void tst_sturm() {
 
 
 
+static void tst_fp_filter() {
+    // compare roots with and without the floating point filter
+    reslimit rl;
+    unsynch_mpq_manager nm;
+    polynomial::manager m(rl, nm);
+    polynomial_ref x(m);
+    x = m.mk_polynomial(m.mk_var());
+    params_ref ps;
+    ps.set_bool("fp_filter", false);
+    algebraic_numbers::manager am(rl, nm);
+    algebraic_numbers::manager am_exact(rl, nm, ps);
+    polynomial_ref_vector ps_list(m);
+    ps_list.push_back((x^2) - 2);
+    ps_list.push_back((x^3) - 3*x + 1);
+    ps_list.push_back((x^5) - x - 1);
+    ps_list.push_back(((x^2) - 2)*((x^3) - 5));
+    ps_list.push_back(1000001*(x^2) - 2000000);
+    ps_list.push_back((x^7) - 7*(x^5) + 14*(x^3) - 7*x + 1);
+    scoped_anum_vector rs(am), rs_exact(am_exact), tmp(am), tmp_exact(am_exact);
+    for (polynomial::polynomial * p : ps_list) {
+        tmp.reset();
+        tmp_exact.reset();
+        am.isolate_roots(polynomial_ref(p, m), tmp);
+        am_exact.isolate_roots(polynomial_ref(p, m), tmp_exact);
+        ENSURE(tmp.size() == tmp_exact.size());
+        for (unsigned i = 0; i < tmp.size(); i++) {
+            rs.push_back(tmp[i]);
+            rs_exact.push_back(tmp_exact[i]);
+        }
+    }
+    for (unsigned i = 0; i < rs.size(); i++) {
+        for (unsigned j = 0; j < rs.size(); j++) {
+            ENSURE(am.compare(rs[i], rs[j]) == am_exact.compare(rs_exact[i], rs_exact[j]));
+        }
+    }
+    statistics st;
+    am.collect_statistics(st);
+    st.display_smt2(std::cout);
+}
+
 void tst_algebraic() {
     tst_sturm();
 
@@ -646,4 +686,5 @@ void tst_algebraic() {
     tst_wilkinson();
     tst1();
     tst_refine_mpbq();
+    tst_fp_filter();
 }
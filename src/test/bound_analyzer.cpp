@@ -0,0 +1,166 @@
+/*++
+Copyright (c) 2020 Microsoft Corporation
+
+Module Name:
+
+    bound_analyzer.cpp
+
+Abstract:
+
+    Compare the bounds found by the int64 path of bound_analyzer_on_row
+    with the bounds found by the exact mpq path.
+
+    The mpq path is exercised by dividing the row and its right side by a
+    prime p that does not divide any of them. The implied bounds do not
+    change, but the coefficients are no longer integers, which rules out
+    the int64 path.
+
+--*/
+
+#include "math/lp/lp_settings.h"
+#include "math/lp/numeric_pair.h"
+#include "math/lp/bound_analyzer_on_row.h"
+#include "util/util.h"
+#include <map>
+
+namespace lp {
+
+    struct test_cell {
+        unsigned m_j;
+        mpq      m_a;
+        unsigned var() const { return m_j; }
+        const mpq & coeff() const { return m_a; }
+    };
+
+    typedef vector<test_cell> test_row;
+
+    class test_propagator {
+        vector<column_type> const & m_types;
+        vector<impq> const &        m_lower;
+        vector<impq> const &        m_upper;
+    public:
+        // (column, is_low) -> best bound and its strictness
+        std::map<std::pair<unsigned, bool>, std::pair<mpq, bool>> m_bounds;
+
+        test_propagator(vector<column_type> const & types, vector<impq> const & lower, vector<impq> const & upper):
+            m_types(types), m_lower(lower), m_upper(upper) {}
+
+        column_type get_column_type(unsigned j) const { return m_types[j]; }
+        const impq & get_lower_bound(unsigned j) const { return m_lower[j]; }
+        const impq & get_upper_bound(unsigned j) const { return m_upper[j]; }
+
+        void try_add_bound(mpq const & v, unsigned j, bool is_low, bool, unsigned, bool strict) {
+            auto k = std::make_pair(j, is_low);
+            auto it = m_bounds.find(k);
+            if (it == m_bounds.end()) {
+                m_bounds[k] = std::make_pair(v, strict);
+                return;
+            }
+            mpq const & old = it->second.first;
+            bool better = is_low ? (v > old || (v == old && strict)) : (v < old || (v == old && strict));
+            if (better)
+                it->second = std::make_pair(v, strict);
+        }
+    };
+
+    static const int s_prime = 1000003;
+
+    static int64_t random_int64(random_gen & r) {
+        uint64_t u = 0;
+        for (unsigned i = 0; i < 5; ++i)
+            u = (u << 15) | static_cast<uint64_t>(r());
+        int64_t v;
+        switch (r() % 6) {
+        case 0: v = static_cast<int64_t>(r() % 10); break;
+        case 1: v = static_cast<int64_t>(u % 1000000); break;
+        case 2: v = INT64_MAX - static_cast<int64_t>(r() % 4); break;
+        case 3: v = INT64_MIN + static_cast<int64_t>(r() % 4); break;
+        case 4: v = static_cast<int64_t>(u >> 2) + (static_cast<int64_t>(1) << 61); break;
+        default: v = static_cast<int64_t>(u); break;
+        }
+        if (v != INT64_MIN && r() % 2 == 0)
+            v = -v;
+        // keep the value coprime to s_prime, so dividing by it gives a non-integer
+        if (v % s_prime == 0)
+            v = v > 0 ? v - 1 : v + 1;
+        return v;
+    }
+
+    static void analyze(test_row const & row, mpq const & rs, test_propagator & bp) {
+        bound_analyzer_on_row<test_row, test_propagator>::analyze_row(row, 0, impq(rs), 0, bp);
+    }
+
+    static void tst_bound_analyzer_row(random_gen & r, unsigned n) {
+        vector<column_type> types;
+        vector<impq> lower, upper;
+        test_row row, scaled;
+        mpq p(s_prime);
+        for (unsigned j = 0; j < n; ++j) {
+            mpq a(random_int64(r), mpq::i64());
+            if (a.is_zero())
+                a = mpq(1);
+            row.push_back({ j, a });
+            scaled.push_back({ j, a / p });
+            column_type t = static_cast<column_type>(r() % 5);
+            mpq l(random_int64(r), mpq::i64()), u(random_int64(r), mpq::i64());
+            if (l > u)
+                std::swap(l, u);
+            if (t == column_type::fixed)
+                u = l;
+            types.push_back(t);
+            lower.push_back(impq(l, mpq(r() % 2 == 0 ? 0 : 1)));
+            upper.push_back(impq(u, mpq(t == column_type::fixed || r() % 2 == 0 ? 0 : -1)));
+            if (t == column_type::fixed)
+                lower.back().y = mpq(0);
+        }
+        mpq rs(random_int64(r), mpq::i64());
+
+        test_propagator bp_int64(types, lower, upper), bp_mpq(types, lower, upper);
+        analyze(row, rs, bp_int64);
+        analyze(scaled, rs / p, bp_mpq);
+
+        ENSURE(bp_int64.m_bounds.size() == bp_mpq.m_bounds.size());
+        for (auto const & kv : bp_int64.m_bounds) {
+            auto it = bp_mpq.m_bounds.find(kv.first);
+            ENSURE(it != bp_mpq.m_bounds.end());
+            ENSURE(it->second.first == kv.second.first);
+            ENSURE(it->second.second == kv.second.second);
+        }
+    }
+
+    // A row with one unbounded column and right side INT64_MIN, whose negation overflows.
+    static void tst_bound_analyzer_int64_min() {
+        vector<column_type> types;
+        vector<impq> lower, upper;
+        test_row row, scaled;
+        mpq p(s_prime);
+        types.push_back(column_type::free_column);
+        lower.push_back(impq(0));
+        upper.push_back(impq(0));
+        row.push_back({ 0, mpq(1) });
+        scaled.push_back({ 0, mpq(1) / p });
+        types.push_back(column_type::boxed);
+        lower.push_back(impq(-5));
+        upper.push_back(impq(7));
+        row.push_back({ 1, mpq(3) });
+        scaled.push_back({ 1, mpq(3) / p });
+        mpq rs(INT64_MIN, mpq::i64());
+
+        test_propagator bp_int64(types, lower, upper), bp_mpq(types, lower, upper);
+        analyze(row, rs, bp_int64);
+        analyze(scaled, rs / p, bp_mpq);
+        // x0 = -rs - 3*x1 lies in [-rs - 21, -rs + 15]
+        auto lo = bp_int64.m_bounds.find(std::make_pair(0u, true));
+        auto hi = bp_int64.m_bounds.find(std::make_pair(0u, false));
+        ENSURE(lo != bp_int64.m_bounds.end() && lo->second.first == -rs - mpq(21));
+        ENSURE(hi != bp_int64.m_bounds.end() && hi->second.first == -rs + mpq(15));
+        ENSURE(bp_int64.m_bounds == bp_mpq.m_bounds);
+    }
+}
+
+void tst_bound_analyzer() {
+    random_gen r(0);
+    for (unsigned i = 0; i < 2000; ++i)
+        lp::tst_bound_analyzer_row(r, 2 + i % 4);
+    lp::tst_bound_analyzer_int64_min();
+}
@@ -202,7 +202,64 @@ void dl_query_test_wpa(smt_params & fparams, params_ref& params) {
 
 }
 
+static unsigned get_stat(statistics const & st, char const * key) {
+    for (unsigned i = 0; i < st.size(); ++i)
+        if (st.is_uint(i) && strcmp(st.get_key(i), key) == 0)
+            return st.get_uint_value(i);
+    return 0;
+}
+
+/**
+   Add edges in batches and ask for the transitive closure after each batch.
+   Return the number of incremental saturations.
+*/
+static unsigned dl_query_incremental(bool incremental, unsigned_vector & sizes) {
+    ast_manager m;
+    reg_decl_plugins(m);
+    register_engine re;
+    smt_params fparams;
+    context ctx(m, re, fparams);
+    params_ref params;
+    params.set_sym("engine", symbol("datalog"));
+    params.set_bool("datalog.incremental", incremental);
+    ctx.updt_params(params);
+    parser* p = parser::create(ctx, m);
+    ENSURE(p->parse_string("N 64\n\nedge(x:N, y:N)\npath(x:N, y:N)\nend(x:N)\n"
+                           "path(x,y) :- edge(x,y).\npath(x,z) :- path(x,y), edge(y,z).\n"
+                           "end(y) :- path(x,y).\n"));
+    dealloc(p);
+    func_decl * edge = ctx.try_get_predicate_decl(symbol("edge"));
+    func_decl * path = ctx.try_get_predicate_decl(symbol("path"));
+    func_decl * end = ctx.try_get_predicate_decl(symbol("end"));
+    ENSURE(edge && path && end);
+    func_decl * outputs[2] = { path, end };
+    for (unsigned round = 0; round < 4; ++round) {
+        for (unsigned i = 0; i < 6; ++i) {
+            unsigned args[2] = { (round * 7 + i * 3) % 20, (round * 5 + i * 11 + 1) % 20 };
+            ctx.add_table_fact(edge, 2, args);
+        }
+        ENSURE(ctx.rel_query(2, outputs) == l_true);
+        unsigned sz = 0;
+        ENSURE(ctx.get_rel_context()->try_get_size(path, sz));
+        sizes.push_back(sz);
+        ENSURE(ctx.get_rel_context()->try_get_size(end, sz));
+        sizes.push_back(sz);
+    }
+    statistics st;
+    ctx.collect_statistics(st);
+    return get_stat(st, "incremental saturations");
+}
+
+static void dl_query_test_incremental() {
+    unsigned_vector full, incremental;
+    ENSURE(dl_query_incremental(false, full) == 0);
+    ENSURE(dl_query_incremental(true, incremental) > 0);
+    ENSURE(full == incremental);
+}
+
 void tst_dl_query() {
+    dl_query_test_incremental();
+
     smt_params fparams;
     params_ref params;
     params.set_sym("default_table", symbol("sparse"));
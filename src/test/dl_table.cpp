@@ -1,9 +1,11 @@
 /*++
 Copyright (c) 2015 Microsoft Corporation
 --*/
+#include <algorithm>
 #include "ast/reg_decl_plugins.h"
 #include "muz/base/dl_context.h"
 #include "muz/rel/dl_table.h"
+#include "muz/rel/dl_sorted_table.h"
 #include "muz/fp/dl_register_engine.h"
 #include "muz/rel/dl_relation_manager.h"
 
@@ -15,6 +17,12 @@ static datalog::table_base* mk_bv_table(datalog::relation_manager& m, datalog::t
     return p->mk_empty(sig);
 }
 
+static datalog::table_base* mk_sorted_table(datalog::relation_manager& m, datalog::table_signature& sig) {
+    datalog::table_plugin * p = m.get_table_plugin(symbol("sorted"));
+    ENSURE(p);
+    return p->mk_empty(sig);
+}
+
 static void test_table(mk_table_fn mk_table) {
     datalog::table_signature sig;
     sig.push_back(2);
@@ -95,6 +103,77 @@ void test_dl_bitvector_table() {
     test_table(mk_bv_table);
 }
 
+void test_dl_sorted_table() {
+    test_table(mk_sorted_table);
+}
+
+static void join_facts(char const* plugin, unsigned num_threads, vector<datalog::table_fact>& facts) {
+    smt_params params;
+    ast_manager ast_m;
+    reg_decl_plugins(ast_m);
+    datalog::register_engine re;
+    datalog::context ctx(ast_m, re, params);
+    params_ref p;
+    p.set_uint("datalog.join_threads", num_threads);
+    p.set_uint("datalog.join_threads_min_rows", 0);
+    ctx.updt_params(p);
+    datalog::relation_manager & m = ctx.get_rel_context()->get_rmanager();
+    datalog::table_plugin * sp = m.get_table_plugin(symbol(plugin));
+    ENSURE(sp);
+
+    datalog::table_signature sig;
+    sig.push_back(64);
+    sig.push_back(64);
+    sig.push_back(1000);
+    datalog::table_base* t1 = sp->mk_empty(sig);
+    datalog::table_base* t2 = sp->mk_empty(sig);
+    datalog::table_fact row;
+    row.resize(3);
+    for (unsigned i = 0; i < 1000; ++i) {
+        row[0] = i % 64; row[1] = (i * 7) % 64; row[2] = i;
+        t1->add_fact(row);
+        row[0] = (i * 13) % 64; row[1] = i % 64; row[2] = i;
+        t2->add_fact(row);
+    }
+    unsigned cols1[2] = { 0, 1 };
+    unsigned cols2[2] = { 1, 0 };
+    unsigned removed[2] = { 3, 4 };
+    datalog::table_join_fn * j = m.mk_join_project_fn(*t1, *t2, 2, cols1, cols2, 2, removed);
+    datalog::table_base* t3 = (*j)(*t1, *t2);
+    datalog::table_base::iterator it = t3->begin(), end = t3->end();
+    for (; it != end; ++it) {
+        it->get_fact(row);
+        facts.push_back(row);
+    }
+    std::sort(facts.begin(), facts.end(), [](datalog::table_fact const& a, datalog::table_fact const& b) {
+        return std::lexicographical_compare(a.begin(), a.end(), b.begin(), b.end());
+    });
+    dealloc(j);
+    t1->deallocate();
+    t2->deallocate();
+    t3->deallocate();
+}
+
+static void test_sparse_parallel_join() {
+    vector<datalog::table_fact> facts1, facts4;
+    join_facts("sparse", 1, facts1);
+    join_facts("sparse", 4, facts4);
+    std::cout << "sparse join rows: " << facts1.size() << "\n";
+    ENSURE(!facts1.empty());
+    ENSURE(facts1 == facts4);
+}
+
+static void test_sorted_join() {
+    vector<datalog::table_fact> sparse_facts, sorted_facts;
+    join_facts("sparse", 1, sparse_facts);
+    join_facts("sorted", 1, sorted_facts);
+    ENSURE(!sparse_facts.empty());
+    ENSURE(sparse_facts == sorted_facts);
+}
+
 void tst_dl_table() {
     test_dl_bitvector_table();
+    test_dl_sorted_table();
+    test_sparse_parallel_join();
+    test_sorted_join();
 }
@@ -17,6 +17,7 @@ Copyright (c) 2015 Microsoft Corporation
 #include "ast/ast_util.h"
 #include "ast/rewriter/expr_safe_replace.h"
 #include "ast/rewriter/th_rewriter.h"
+#include "util/stopwatch.h"
 
 
 static void tst_doc1(unsigned n) {
@@ -476,6 +477,62 @@ public:
 };
 
 
+static tbv* mk_random_tbv(tbv_manager& m, random_gen& rand, tbv const* base) {
+    tbv* t = base ? m.allocate(*base) : m.allocateX();
+    for (unsigned i = 0; i < m.num_tbits(); ++i) {
+        if ((*t)[i] != BIT_x || rand(base ? 32 : 8) != 0)
+            continue;
+        m.set(*t, i, rand(2) ? BIT_1 : BIT_0);
+    }
+    return t;
+}
+
+// compare doc operations on the SIMD tbv kernels with the scalar ones and time both.
+static void tst_doc_kernels(unsigned n, unsigned num_docs, unsigned num_rounds) {
+    doc_manager m(n);
+    tbv_manager& tm = m.tbvm();
+    random_gen rand(n);
+    ptr_vector<doc> docs;
+    for (unsigned i = 0; i < num_docs; ++i) {
+        doc* d = m.allocate(mk_random_tbv(tm, rand, nullptr));
+        for (unsigned k = rand(3); k-- > 0; )
+            d->neg().push_back(mk_random_tbv(tm, rand, &d->pos()));
+        docs.push_back(d);
+    }
+    doc_ref r1(m, m.allocate()), r2(m, m.allocate());
+    for (doc* a : docs) {
+        for (doc* b : docs) {
+            tm.set_simd(false);
+            bool i1 = m.intersect(*a, *b, *r1);
+            bool c1 = m.contains(*a, *b), e1 = m.equals(*a, *b);
+            tm.set_simd(true);
+            bool i2 = m.intersect(*a, *b, *r2);
+            ENSURE(i1 == i2);
+            ENSURE(!i1 || m.equals(*r1, *r2));
+            ENSURE(c1 == m.contains(*a, *b));
+            ENSURE(e1 == m.equals(*a, *b));
+        }
+    }
+    for (unsigned simd = 0; simd < 2; ++simd) {
+        tm.set_simd(simd != 0);
+        stopwatch sw;
+        sw.start();
+        unsigned k = 0;
+        for (unsigned round = 0; round < num_rounds; ++round) {
+            for (doc* a : docs) {
+                for (doc* b : docs) {
+                    k += m.intersect(*a, *b, *r1);
+                    k += m.contains(*a, *b);
+                }
+            }
+        }
+        sw.stop();
+        std::cout << n << " bits " << tm.kernels_name() << ": " << k << " " << sw.get_seconds() << "s\n";
+    }
+    for (doc* d : docs)
+        m.deallocate(d);
+}
+
 void tst_doc() {
 
     test_doc_cls tp(4);
@@ -489,4 +546,8 @@ void tst_doc() {
     tst_doc1(5);
     tst_doc1(10);
     tst_doc1(70);
+
+    tst_doc_kernels(20, 30, 1);
+    tst_doc_kernels(256, 40, 5);
+    tst_doc_kernels(1000, 40, 5);
 }
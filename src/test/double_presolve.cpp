@@ -0,0 +1,92 @@
+/*++
+Copyright (c) 2020 Microsoft Corporation
+
+Module Name:
+
+    double_presolve.cpp
+
+Abstract:
+
+    Compare the arithmetic solver with arith.presolve_with_doubles=true
+    against the exact-only solver on random linear real arithmetic problems.
+
+--*/
+
+#include "ast/reg_decl_plugins.h"
+#include "ast/arith_decl_plugin.h"
+#include "smt/smt_kernel.h"
+#include "smt/params/smt_params.h"
+#include "util/util.h"
+
+static unsigned get_stat(statistics const & st, char const * key) {
+    for (unsigned i = 0; i < st.size(); ++i)
+        if (st.is_uint(i) && strcmp(st.get_key(i), key) == 0)
+            return st.get_uint_value(i);
+    return 0;
+}
+
+static lbool check_lra(ast_manager & m, expr_ref_vector const & fmls, bool presolve, unsigned & num_presolves) {
+    smt_params fp;
+    params_ref p;
+    p.set_bool("arith.presolve_with_doubles", presolve);
+    fp.updt_params(p);
+    smt::kernel k(m, fp, p);
+    for (expr * f : fmls)
+        k.assert_expr(f);
+    lbool r = k.check();
+    if (r == l_true) {
+        model_ref mdl;
+        k.get_model(mdl);
+        for (expr * f : fmls)
+            ENSURE(mdl->is_true(f));
+    }
+    statistics st;
+    k.collect_statistics(st);
+    num_presolves += get_stat(st, "arith-double-presolves");
+    return r;
+}
+
+static void tst_double_presolve(random_gen & r, unsigned num_vars, unsigned num_rows, unsigned & num_presolves) {
+    unsigned num_exact_presolves = 0;
+    ast_manager m;
+    reg_decl_plugins(m);
+    arith_util a(m);
+    expr_ref_vector xs(m), fmls(m);
+    for (unsigned j = 0; j < num_vars; ++j) {
+        xs.push_back(m.mk_fresh_const("x", a.mk_real()));
+        fmls.push_back(a.mk_le(a.mk_numeral(rational(-100), false), xs.back()));
+        fmls.push_back(a.mk_le(xs.back(), a.mk_numeral(rational(100), false)));
+    }
+    for (unsigned i = 0; i < num_rows; ++i) {
+        expr_ref_vector ts(m);
+        for (unsigned j = 0; j < num_vars; ++j) {
+            int c = static_cast<int>(r() % 21) - 10;
+            if (c != 0)
+                ts.push_back(a.mk_mul(a.mk_numeral(rational(c), false), xs.get(j)));
+        }
+        if (ts.empty())
+            continue;
+        expr_ref lhs(a.mk_add(ts.size(), ts.data()), m);
+        rational b(static_cast<int>(r() % 41) - 20);
+        if (r() % 4 == 0)
+            b /= rational(static_cast<int>(r() % 7) + 1);
+        expr_ref rhs(a.mk_numeral(b, false), m);
+        switch (r() % 3) {
+        case 0: fmls.push_back(a.mk_le(lhs, rhs)); break;
+        case 1: fmls.push_back(a.mk_ge(lhs, rhs)); break;
+        default: fmls.push_back(m.mk_not(a.mk_le(lhs, rhs))); break;
+        }
+    }
+    lbool exact = check_lra(m, fmls, false, num_exact_presolves);
+    ENSURE(num_exact_presolves == 0);
+    ENSURE(check_lra(m, fmls, true, num_presolves) == exact);
+}
+
+void tst_double_presolve() {
+    random_gen r(0);
+    unsigned num_presolves = 0;
+    for (unsigned i = 0; i < 200; ++i)
+        tst_double_presolve(r, 4 + i % 8, 6 + i % 20, num_presolves);
+    // the double solver was used for some of the problems
+    ENSURE(num_presolves > 0);
+}
@@ -0,0 +1,134 @@
+/*++
+Copyright (c) 2020 Microsoft Corporation
+
+Module Name:
+
+    int_cut_pool.cpp
+
+Abstract:
+
+    Tests for the pool of integer cuts that survives backtracking.
+
+--*/
+
+#include "math/lp/lar_solver.h"
+#include "math/lp/int_solver.h"
+#include "math/lp/int_cut_pool.h"
+
+namespace lp {
+
+    static bool find_cut(int_cut_pool & pool, mpq & k, explanation & ex) {
+        lar_term t;
+        bool upper;
+        return pool.find(t, k, upper, ex);
+    }
+
+    static void tst_int_cut_pool_bounds() {
+        lar_solver s;
+        params_ref p;
+        p.set_uint("arith.cut_pool_size", 8);
+        s.settings().updt_params(p);
+        int_solver lia(s);
+        int_cut_pool & pool = lia.cut_pool();
+        var_index x = s.add_var(0, true);
+        var_index y = s.add_var(1, true);
+        mpq k;
+        explanation ex;
+
+        // x + y >= 12 recorded while x >= 5 and y >= 5
+        s.push();
+        constraint_index cx = s.add_var_bound(x, GE, mpq(5));
+        constraint_index cy = s.add_var_bound(y, GE, mpq(5));
+        s.add_var_bound(x, LE, mpq(20));
+        s.add_var_bound(y, LE, mpq(20));
+        VERIFY(s.find_feasible_solution() == lp_status::OPTIMAL);
+        ENSURE(s.get_column_value(x) + s.get_column_value(y) < impq(12));
+        lar_term t;
+        t.add_monomial(mpq(1), x);
+        t.add_monomial(mpq(1), y);
+        explanation cut_ex;
+        cut_ex.push_back(cx);
+        cut_ex.push_back(cy);
+        pool.record(t, mpq(12), false, cut_ex);
+        ENSURE(pool.size() == 1);
+        ENSURE(find_cut(pool, k, ex));
+        ENSURE(k == mpq(12));
+        ENSURE(ex.size() == 2);
+        s.pop(1);
+
+        // the bounds are gone
+        ENSURE(!find_cut(pool, k, ex));
+
+        // x >= 4 is weaker than the recorded x >= 5
+        s.push();
+        s.add_var_bound(x, GE, mpq(4));
+        s.add_var_bound(y, GE, mpq(5));
+        s.add_var_bound(x, LE, mpq(20));
+        s.add_var_bound(y, LE, mpq(20));
+        VERIFY(s.find_feasible_solution() == lp_status::OPTIMAL);
+        ENSURE(s.get_column_value(x) + s.get_column_value(y) < impq(12));
+        ENSURE(!find_cut(pool, k, ex));
+        s.pop(1);
+
+        // x >= 6 is tighter, the cut is reused with the current witnesses
+        s.push();
+        constraint_index cx6 = s.add_var_bound(x, GE, mpq(6));
+        constraint_index cy5 = s.add_var_bound(y, GE, mpq(5));
+        s.add_var_bound(x, LE, mpq(20));
+        s.add_var_bound(y, LE, mpq(20));
+        VERIFY(s.find_feasible_solution() == lp_status::OPTIMAL);
+        ENSURE(s.get_column_value(x) + s.get_column_value(y) < impq(12));
+        explanation ex6;
+        ENSURE(find_cut(pool, k, ex6));
+        bool has_cx6 = false, has_cy5 = false;
+        for (auto ev : ex6) {
+            has_cx6 |= ev.ci() == cx6;
+            has_cy5 |= ev.ci() == cy5;
+        }
+        ENSURE(has_cx6 && has_cy5);
+        s.pop(1);
+        ENSURE(pool.size() == 1);
+    }
+
+    static void tst_int_cut_pool_pop_columns() {
+        lar_solver s;
+        params_ref p;
+        p.set_uint("arith.cut_pool_size", 8);
+        s.settings().updt_params(p);
+        int_solver lia(s);
+        int_cut_pool & pool = lia.cut_pool();
+        var_index x = s.add_var(0, true);
+        constraint_index cx = s.add_var_bound(x, GE, mpq(1));
+        lar_term tx;
+        tx.add_monomial(mpq(1), x);
+        explanation ex;
+        ex.push_back(cx);
+        pool.record(tx, mpq(3), false, ex);
+        ENSURE(pool.size() == 1);
+
+        s.push();
+        var_index z = s.add_var(1, true);
+        constraint_index cz = s.add_var_bound(z, GE, mpq(1));
+        lar_term tz;
+        tz.add_monomial(mpq(1), x);
+        tz.add_monomial(mpq(1), z);
+        explanation exz;
+        exz.push_back(cx);
+        exz.push_back(cz);
+        pool.record(tz, mpq(5), false, exz);
+        ENSURE(pool.size() == 2);
+        s.pop(1);
+        // the cut over z is dropped, the cut over x is kept
+        ENSURE(pool.size() == 1);
+        VERIFY(s.find_feasible_solution() == lp_status::OPTIMAL);
+        mpq k;
+        explanation ex1;
+        ENSURE(find_cut(pool, k, ex1));
+        ENSURE(k == mpq(3));
+    }
+}
+
+void tst_int_cut_pool() {
+    lp::tst_int_cut_pool_bounds();
+    lp::tst_int_cut_pool_pop_columns();
+}
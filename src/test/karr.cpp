@@ -5,6 +5,11 @@ Copyright (c) 2015 Microsoft Corporation
 --*/
 #include "util/rlimit.h"
 #include "math/hilbert/hilbert_basis.h"
+#include "ast/reg_decl_plugins.h"
+#include "muz/base/dl_context.h"
+#include "muz/fp/dl_register_engine.h"
+#include "muz/rel/dl_relation_manager.h"
+#include "muz/rel/karr_relation.h"
 
 /*
   Test generation of linear congruences a la Karr.
@@ -295,7 +300,120 @@ namespace karr {
 
 };
 
+namespace karr {
+
+    // rank of the rows (A[i], b[i]) over the rationals.
+    static unsigned rank(datalog::matrix const& M) {
+        vector<vector<rational>> rows;
+        for (unsigned i = 0; i < M.size(); ++i) {
+            rows.push_back(M.A[i]);
+            rows.back().push_back(M.b[i]);
+        }
+        unsigned r = 0;
+        unsigned num_cols = rows.empty() ? 0 : rows[0].size();
+        for (unsigned j = 0; j < num_cols && r < rows.size(); ++j) {
+            unsigned p = r;
+            while (p < rows.size() && rows[p][j].is_zero()) ++p;
+            if (p == rows.size()) continue;
+            std::swap(rows[p], rows[r]);
+            for (unsigned i = r + 1; i < rows.size(); ++i) {
+                rational c = rows[i][j] / rows[r][j];
+                for (unsigned k = j; k < num_cols; ++k)
+                    rows[i][k] -= c * rows[r][k];
+            }
+            ++r;
+        }
+        return r;
+    }
+
+    // the rows of M and N span the same space.
+    static bool same_span(datalog::matrix const& M, datalog::matrix const& N) {
+        datalog::matrix MN(M);
+        MN.append(N);
+        unsigned r = rank(MN);
+        return rank(M) == r && rank(N) == r;
+    }
+
+    // the same system with every equality replaced by two inequalities,
+    // which rules out the elimination for systems of equalities.
+    static void split_eqs(datalog::matrix& dst, datalog::matrix const& src) {
+        dst.reset();
+        for (unsigned i = 0; i < src.size(); ++i) {
+            dst.A.push_back(src.A[i]);
+            dst.b.push_back(src.b[i]);
+            dst.eq.push_back(false);
+            vector<rational> neg;
+            for (rational const& c : src.A[i])
+                neg.push_back(-c);
+            dst.A.push_back(neg);
+            dst.b.push_back(-src.b[i]);
+            dst.eq.push_back(false);
+        }
+    }
+
+    // random equalities A*x + b = 0 with the integer solution x0.
+    static void mk_random_eqs(random_gen& r, unsigned num_rows, unsigned num_cols, datalog::matrix& M) {
+        M.reset();
+        vector<rational> x0;
+        for (unsigned j = 0; j < num_cols; ++j)
+            x0.push_back(rational(static_cast<int>(r() % 7) - 3));
+        for (unsigned i = 0; i < num_rows; ++i) {
+            vector<rational> row;
+            rational b(0);
+            for (unsigned j = 0; j < num_cols; ++j) {
+                row.push_back(rational(static_cast<int>(r() % 5) - 2));
+                b -= row.back() * x0[j];
+            }
+            M.A.push_back(row);
+            M.b.push_back(b);
+            M.eq.push_back(true);
+        }
+    }
+
+    static void tst_dualize(datalog::karr_relation_plugin& p, datalog::matrix const& src) {
+        datalog::matrix split, dst1, dst2;
+        split_eqs(split, src);
+        bool sat1 = p.dualizeI(dst1, src);
+        bool sat2 = p.dualizeI(dst2, split);
+        ENSURE(sat1 == sat2);
+        // both describe the same affine hull
+        ENSURE(!sat1 || same_span(dst1, dst2));
+        if (!sat1 || dst1.size() == 0)
+            return;
+        datalog::matrix eqs1, eqs2, split1;
+        split_eqs(split1, dst1);
+        p.dualizeH(eqs1, dst1);
+        p.dualizeH(eqs2, split1);
+        ENSURE(same_span(eqs1, eqs2));
+        // the equalities hold at the points of the hull
+        for (unsigned i = 0; i < eqs1.size(); ++i) {
+            for (unsigned k = 0; k < dst1.size(); ++k) {
+                rational s = eqs1.b[i] * dst1.b[k];
+                for (unsigned j = 0; j < dst1.A[k].size(); ++j)
+                    s += eqs1.A[i][j] * dst1.A[k][j];
+                ENSURE(s.is_zero());
+            }
+        }
+    }
+
+    static void tst_dualize_eqs() {
+        smt_params params;
+        ast_manager m;
+        reg_decl_plugins(m);
+        datalog::register_engine re;
+        datalog::context ctx(m, re, params);
+        datalog::karr_relation_plugin p(ctx.get_rel_context()->get_rmanager());
+        random_gen r(0);
+        for (unsigned i = 0; i < 100; ++i) {
+            datalog::matrix src;
+            mk_random_eqs(r, 1 + i % 3, 2 + i % 3, src);
+            tst_dualize(p, src);
+        }
+    }
+};
+
 void tst_karr() {
+    karr::tst_dualize_eqs();
     karr::tst3();
     return;
     karr::tst1();
@@ -155,12 +155,15 @@ int main(int argc, char ** argv) {
     TST(hashtable);
     TST(rational);
     TST(inf_rational);
+    TST(int_cut_pool);
     TST(ast);
     TST(optional);
     TST(bit_vector);
+    TST(bound_analyzer);
     TST(fixed_bit_vector);
     TST(tbv);
     TST(doc);
+    TST(double_presolve);
     TST(udoc_relation);
     TST(string_buffer);
     TST(map);
@@ -227,6 +230,7 @@ int main(int argc, char ** argv) {
     TST(trigo);
     TST(bits);
     TST(mpbq);
+    TST(mpz_bench);
     TST(mpfx);
     TST(mpff);
     TST(horn_subsume_model_converter);
@@ -240,6 +244,7 @@ int main(int argc, char ** argv) {
     TST_ARGV(datalog_parser_file);
     TST(dl_query);
     TST(quant_solve);
+    TST(quantifier_instance_cache);
     TST(rcf);
     TST(polynorm);
     TST(qe_arith);
@@ -250,6 +255,7 @@ int main(int argc, char ** argv) {
     TST(sat_user_scope);
     TST_ARGV(ddnf);
     TST(ddnf1);
+    TST(model_checker);
     TST(model_evaluator);
     TST(get_consequences);
     TST(pb2bv);
@@ -260,6 +266,7 @@ int main(int argc, char ** argv) {
     TST(pdd);
     TST(pdd_solver);
     TST(solver_pool);
+    TST(spacer);
     //TST_ARGV(hs);
     TST(finder);
 }
@@ -0,0 +1,78 @@
+/*++
+Copyright (c) 2020 Microsoft Corporation
+
+Module Name:
+
+    model_checker.cpp
+
+Abstract:
+
+    Compare MBQI with a pool of auxiliary contexts (smt.mbqi.threads > 1)
+    against sequential MBQI.
+
+--*/
+
+#include "ast/reg_decl_plugins.h"
+#include "cmd_context/cmd_context.h"
+#include "parsers/smt2/smt2parser.h"
+#include "smt/smt_kernel.h"
+#include "smt/params/smt_params.h"
+#include <sstream>
+
+static lbool check_mbqi(char const * benchmark, unsigned num_threads) {
+    ast_manager m;
+    reg_decl_plugins(m);
+    cmd_context ctx(false, &m);
+    std::istringstream is(benchmark);
+    VERIFY(parse_smt2_commands(ctx, is));
+    smt_params fp;
+    fp.m_ematching = false;
+    fp.m_mbqi = true;
+    fp.m_mbqi_threads = num_threads;
+    smt::kernel k(m, fp);
+    for (expr * a : ctx.assertions())
+        k.assert_expr(a);
+    lbool r = k.check();
+    if (r == l_true) {
+        model_ref mdl;
+        k.get_model(mdl);
+        for (expr * a : ctx.assertions())
+            if (is_ground(a))
+                ENSURE(mdl->is_true(a));
+    }
+    return r;
+}
+
+static void tst_mbqi_threads(char const * benchmark, lbool expected) {
+    ENSURE(check_mbqi(benchmark, 1) == expected);
+    ENSURE(check_mbqi(benchmark, 2) == expected);
+    ENSURE(check_mbqi(benchmark, 3) == expected);
+}
+
+void tst_model_checker() {
+    tst_mbqi_threads(
+        "(declare-fun f (Int) Int)\n"
+        "(declare-fun g (Int) Int)\n"
+        "(declare-fun h (Int) Int)\n"
+        "(assert (forall ((x Int)) (>= (f x) 0)))\n"
+        "(assert (forall ((x Int)) (= (g x) (+ (f x) 1))))\n"
+        "(assert (forall ((x Int)) (>= (h x) (g x))))\n"
+        "(assert (> (g 3) 5))\n",
+        l_true);
+    tst_mbqi_threads(
+        "(declare-fun f (Int) Int)\n"
+        "(declare-fun g (Int) Int)\n"
+        "(assert (forall ((x Int)) (> (f x) x)))\n"
+        "(assert (forall ((x Int)) (< (f x) (g x))))\n"
+        "(assert (forall ((x Int)) (<= (g x) (+ x 1))))\n",
+        l_false);
+    tst_mbqi_threads(
+        "(declare-sort U 0)\n"
+        "(declare-fun p (U U) Bool)\n"
+        "(declare-const a U)\n"
+        "(declare-const b U)\n"
+        "(assert (forall ((x U)) (not (p x x))))\n"
+        "(assert (forall ((x U) (y U) (z U)) (=> (and (p x y) (p y z)) (p x z))))\n"
+        "(assert (p a b))\n",
+        l_true);
+}
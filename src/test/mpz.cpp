@@ -503,9 +503,189 @@ static void tst_pw2() {
     }
 }
 
+static void mk_random_bits(unsynch_mpz_manager & m, unsigned num_bits, mpz & r) {
+    scoped_mpz d(m);
+    m.set(r, 0);
+    for (unsigned i = 0; i < num_bits; i += 30) {
+        m.mul2k(r, 30);
+        m.set(d, rand() & ((1 << 30) - 1));
+        m.add(r, d, r);
+    }
+}
+
+// compare products against a digit-by-digit computation.
+static void tst_mul_large() {
+    unsynch_mpz_manager m;
+    scoped_mpz a(m), b(m), c(m), expected(m), d(m), t(m), q(m), r(m);
+    unsigned sizes[] = { 31, 1000, 1024, 1056, 2048, 3000, 8200 };
+    for (unsigned sa : sizes) {
+        for (unsigned sb : sizes) {
+            mk_random_bits(m, sa, a);
+            mk_random_bits(m, sb, b);
+            m.mul(a, b, c);
+            m.set(expected, 0);
+            m.set(t, a);
+            for (unsigned shift = 0; !m.is_zero(t); shift += 32) {
+                m.machine_div2k(t, 32, q);
+                m.mul2k(q, 32, d);
+                m.sub(t, d, d);
+                m.mul(d, b, d);
+                m.mul2k(d, shift);
+                m.add(expected, d, expected);
+                m.set(t, q);
+            }
+            ENSURE(m.eq(c, expected));
+            // (a*b + b - 1) div b = a
+            m.add(c, b, c);
+            m.dec(c);
+            m.machine_div_rem(c, b, q, r);
+            ENSURE(m.eq(q, a));
+            m.inc(r);
+            ENSURE(m.eq(r, b));
+        }
+    }
+}
+
+static void bench_mul(unsigned num_bits, unsigned num_iterations) {
+    unsynch_mpz_manager m;
+    scoped_mpz a(m), b(m), c(m);
+    mk_random_bits(m, num_bits, a);
+    mk_random_bits(m, num_bits, b);
+    std::string msg = "mul " + std::to_string(num_bits) + " bits x " + std::to_string(num_iterations);
+    {
+        timeit tt(true, msg.c_str(), std::cout);
+        for (unsigned i = 0; i < num_iterations; i++)
+            m.mul(a, b, c);
+    }
+    msg = "to_string " + std::to_string(2 * num_bits) + " bits";
+    {
+        timeit tt(true, msg.c_str(), std::cout);
+        std::string str = m.to_string(c);
+        std::cout << str.size() << " decimal digits\n";
+    }
+}
+
+// results around the 62-bit boundary of small numbers agree with the big number code.
+static void tst_small_int64() {
+    unsynch_mpz_manager m;
+    scoped_mpz a(m), b(m), c(m), d(m), q(m), r(m);
+    int64_t max_small = (static_cast<int64_t>(1) << 61) - 1;
+    int64_t vals[] = { 0, 1, -1, INT_MAX, INT_MIN, static_cast<int64_t>(INT_MAX) + 1, 
+                       static_cast<int64_t>(UINT_MAX), static_cast<int64_t>(UINT_MAX) + 1,
+                       static_cast<int64_t>(1) << 40, max_small, -max_small, max_small + 1, 
+                       -max_small - 1, INT64_MAX, INT64_MIN + 1, 3037000499ll, -3037000499ll };
+    for (int64_t x : vals) {
+        m.set(a, x);
+        ENSURE(m.is_int64(a) && m.get_int64(a) == x);
+        ENSURE(m.is_small(a) == (-max_small <= x && x <= max_small));
+        // neg and abs
+        m.set(b, a);
+        m.neg(b);
+        m.neg(b);
+        ENSURE(m.eq(a, b) && m.is_small(b) == m.is_small(a));
+        m.set(b, a);
+        m.abs(b);
+        ENSURE(m.is_nonneg(b));
+        for (int64_t y : vals) {
+            m.set(b, y);
+            // a * b compared with (a * 2^k) * b / 2^k, which goes through big numbers
+            m.mul(a, b, c);
+            m.mul2k(a, 70, d);
+            m.mul(d, b, d);
+            m.machine_div2k(d, 70);
+            ENSURE(m.eq(c, d));
+            // sum and difference through big numbers 
+            m.add(a, b, c);
+            m.mul2k(a, 70, d);
+            m.mul2k(b, 70, q);
+            m.add(d, q, d);
+            m.machine_div2k(d, 70);
+            ENSURE(m.eq(c, d));
+            m.sub(c, b, c);
+            ENSURE(m.eq(c, a));
+            // results that fit are small, so equal numbers hash the same
+            ENSURE(m.is_small(c) == m.is_small(a));
+            ENSURE(m.hash(c) == m.hash(a));
+            if (y != 0) {
+                m.machine_div_rem(a, b, q, r);
+                m.mul(q, b, c);
+                m.add(c, r, c);
+                ENSURE(m.eq(c, a));
+                m.gcd(a, b, c);
+                ENSURE(m.divides(c, a) && m.divides(c, b));
+            }
+        }
+    }
+    // 2^k - 1, 2^k and 2^k + 1 around the boundary
+    for (unsigned k = 28; k < 66; ++k) {
+        m.power(mpz(2), k, a);
+        ENSURE(m.log2(a) == k && m.power_of_two_multiple(a) == k);
+        ENSURE(m.is_power_of_two(a));
+        ENSURE(m.get_bit(a, k) && !m.get_bit(a, k - 1));
+        m.set(b, a);
+        m.neg(b);
+        ENSURE(m.mlog2(b) == k);
+        m.dec(a);
+        ENSURE(m.log2(a) == k - 1);
+        svector<digit_t> ds;
+        ENSURE(!m.decompose(a, ds));
+        m.set_digits(c, ds.size(), ds.data());
+        ENSURE(m.eq(a, c));
+        m.add(a, mpz(2), a);
+        m.set(c, a);
+        m.machine_div2k(c, 1);
+        m.mul2k(c, 1);
+        m.inc(c);
+        ENSURE(m.eq(a, c));
+    }
+    ENSURE(!rational(static_cast<int64_t>(1) << 40, rational::i64()).is_int32());
+    ENSURE(rational(-7).is_int32());
+}
+
+// rationals that alternate between big and small values, as tableau entries do while pivoting.
+static void churn_rationals(unsigned num_rationals, unsigned num_rounds) {
+    rational big = power(rational(2), 100);
+    vector<rational> rs;
+    for (unsigned i = 0; i < num_rationals; ++i)
+        rs.push_back(rational(i));
+    for (unsigned round = 0; round < num_rounds; ++round) {
+        for (unsigned i = 0; i < num_rationals; ++i)
+            rs[i] += big;
+        for (unsigned i = 0; i < num_rationals; ++i) {
+            rs[i] -= big;
+            ENSURE(rs[i] == rational(i));
+        }
+    }
+}
+
+// the big number cells recycled by the synchronized managers are bounded.
+static void tst_cell_cache() {
+    churn_rationals(100, 10);
+    unsigned long long before = memory::get_allocation_size();
+    churn_rationals(20000, 3);
+    // the memory manager synchronizes its counters every 100000 bytes per thread
+    ENSURE(memory::get_allocation_size() <= before + 64 * 1024 + 2 * 100000);
+}
+
+static void bench_cell_cache(unsigned num_rationals, unsigned num_rounds) {
+    std::string msg = "big/small rationals " + std::to_string(num_rationals) + " x " + std::to_string(num_rounds);
+    timeit tt(true, msg.c_str(), std::cout);
+    churn_rationals(num_rationals, num_rounds);
+}
+
+// timings only, not run with /a.
+void tst_mpz_bench() {
+    bench_mul(4096, 1000);
+    bench_mul(32768, 20);
+    bench_cell_cache(1000, 10000);
+}
+
 void tst_mpz() {
     disable_trace("mpz");
     enable_trace("mpz_2k");
+    tst_mul_large();
+    tst_small_int64();
+    tst_cell_cache();
     tst_pw2();
     tst5();
     tst_div2k_bug();
@@ -789,7 +789,93 @@ x7 := 1
 
 }
 
+static unsigned get_stat(statistics const & st, char const * key) {
+    for (unsigned i = 0; i < st.size(); ++i)
+        if (st.is_uint(i) && strcmp(st.get_key(i), key) == 0)
+            return st.get_uint_value(i);
+    return 0;
+}
+
+static polynomial_ref mk_random_poly(random_gen & r, nlsat::pmanager & pm, polynomial_ref_vector const & xs, unsigned deg, unsigned num_monomials) {
+    polynomial_ref p(pm), m(pm), x(pm);
+    p = pm.mk_zero();
+    for (unsigned i = 0; i < num_monomials; ++i) {
+        m = pm.mk_const(rational(static_cast<int>(r() % 11) - 5));
+        for (unsigned j = 0; j < xs.size(); ++j) {
+            x = xs.get(j);
+            m = m * (x ^ (r() % (deg + 1)));
+        }
+        p = p + m;
+    }
+    return p;
+}
+
+// Solve a random problem of num_clauses binary clauses over num_vars variables.
+// The problem only depends on seed, not on the parameters.
+static lbool check_random_nlsat(unsigned seed, unsigned num_vars, unsigned num_clauses, params_ref const & ps, statistics & st) {
+    random_gen r(seed);
+    reslimit rlim;
+    nlsat::solver s(rlim, ps, false);
+    nlsat::pmanager & pm = s.pm();
+    polynomial_ref_vector xs(pm);
+    for (unsigned i = 0; i < num_vars; ++i)
+        xs.push_back(pm.mk_polynomial(s.mk_var(false)));
+    polynomial_ref p(pm);
+    for (unsigned i = 0; i < num_clauses; ++i) {
+        nlsat::literal_vector lits;
+        for (unsigned j = 0; j < 2; ++j) {
+            p = mk_random_poly(r, pm, xs, 2, 4);
+            nlsat::poly * _p[1] = { p.get() };
+            bool is_even[1] = { false };
+            nlsat::atom::kind k = r() % 2 == 0 ? nlsat::atom::LT : nlsat::atom::GT;
+            lits.push_back(s.mk_ineq_literal(k, 1, _p, is_even));
+        }
+        s.mk_clause(lits.size(), lits.data());
+    }
+    lbool result = s.check();
+    s.collect_statistics(st);
+    return result;
+}
+
+static void tst_psc_threads() {
+    params_ref seq, par;
+    par.set_uint("psc_threads", 4);
+    unsigned num_prefetched = 0;
+    for (unsigned seed = 0; seed < 40; ++seed) {
+        statistics st_seq, st_par;
+        lbool r1 = check_random_nlsat(seed, 3, 6, seq, st_seq);
+        lbool r2 = check_random_nlsat(seed, 3, 6, par, st_par);
+        ENSURE(r1 == r2);
+        ENSURE(get_stat(st_seq, "nlsat psc chains prefetched") == 0);
+        // the prefetched chains lead to the same search
+        ENSURE(get_stat(st_seq, "nlsat conflicts") == get_stat(st_par, "nlsat conflicts"));
+        num_prefetched += get_stat(st_par, "nlsat psc chains prefetched");
+    }
+    ENSURE(num_prefetched > 0);
+}
+
+static void tst_projection_cache_eviction() {
+    params_ref unbounded, bounded;
+    bounded.set_uint("projection_cache_size", 4);
+    unsigned num_evictions = 0, num_released = 0;
+    for (unsigned seed = 0; seed < 40; ++seed) {
+        statistics st1, st2;
+        lbool r1 = check_random_nlsat(seed, 3, 6, unbounded, st1);
+        lbool r2 = check_random_nlsat(seed, 3, 6, bounded, st2);
+        ENSURE(r1 == r2);
+        ENSURE(get_stat(st1, "nlsat projection cache evictions") == 0);
+        // evicted entries are recomputed, the search is the same
+        ENSURE(get_stat(st1, "nlsat conflicts") == get_stat(st2, "nlsat conflicts"));
+        num_evictions += get_stat(st2, "nlsat projection cache evictions");
+        num_released += get_stat(st2, "nlsat projection cache released polynomials");
+    }
+    ENSURE(num_evictions > 0);
+    ENSURE(num_released > 0);
+}
+
 void tst_nlsat() {
+    tst_psc_threads();
+    tst_projection_cache_eviction();
     tst11();
     std::cout << "------------------\n";
     return;
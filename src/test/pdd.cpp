@@ -101,6 +101,23 @@ public :
         std::cout << e << "\n";
     }
 
+    /**
+     * a tiny op cache must not change the results
+     */
+    static void small_cache() {
+        std::cout << "\nsmall cache\n";
+        pdd_manager m(4), m2(4);
+        m2.set_max_op_cache_size(16);
+        pdd e = m.mk_var(0) + m.mk_var(2) + 1;
+        pdd e2 = m2.mk_var(0) + m2.mk_var(2) + 1;
+        for (unsigned i = 0; i < 5; i++) {
+            e = e * e - m.mk_var(1);
+            e2 = e2 * e2 - m2.mk_var(1);
+            VERIFY(m2.translate(e) == e2);
+        }
+        std::cout << e2.tree_size() << "\n";
+    }
+
     static void reset() {
         std::cout << "\ntest reset\n";
         pdd_manager m(4);
@@ -330,6 +347,7 @@ void tst_pdd() {
     dd::test::hello_world();
     dd::test::reduce();
     dd::test::large_product();
+    dd::test::small_cache();
     dd::test::canonize();
     dd::test::reset();
     dd::test::iterator();
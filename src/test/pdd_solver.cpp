@@ -77,6 +77,91 @@ namespace dd {
         // 
     }
 
+    static unsigned get_stat(solver const& gb, char const* key) {
+        statistics st;
+        gb.collect_statistics(st);
+        for (unsigned i = 0; i < st.size(); ++i)
+            if (st.is_uint(i) && strcmp(st.get_key(i), key) == 0)
+                return st.get_uint_value(i);
+        return 0;
+    }
+
+    // every equation of gb1 reduces to zero by the equations of gb2
+    static bool reduces_to_zero(solver& gb1, solver& gb2, pdd_manager& m2) {
+        for (auto* e : gb1.equations()) {
+            pdd r = m2.translate(e->poly());
+            bool reduced = true;
+            while (reduced && !r.is_zero()) {
+                reduced = false;
+                for (auto* f : gb2.equations()) {
+                    pdd r1 = r.reduce(f->poly());
+                    if (r1 != r) {
+                        r = r1;
+                        reduced = true;
+                    }
+                }
+            }
+            if (!r.is_zero())
+                return false;
+        }
+        return true;
+    }
+
+    // the same saturation with and without parallel superposition
+    void test3() {
+        unsigned n = 6;
+        pdd_manager m(n), m2(n);
+        reslimit lim;
+        solver gb1(lim, m), gb4(lim, m2);
+        solver::config cfg;
+        cfg.m_max_steps = 60;
+        gb1.set(cfg);
+        cfg.m_threads = 4;
+        gb4.set(cfg);
+        for (unsigned i = 0; i < n; ++i) {
+            pdd x = m.mk_var(i), y = m.mk_var((i + 1) % n);
+            pdd z = m.mk_var((i + 2) % n), w = m.mk_var((i + 3) % n);
+            for (pdd p : { x*y - z*z - 1, x*z + w - 2, y*w*x - x + i }) {
+                gb1.add(p);
+                gb4.add(m2.translate(p));
+            }
+        }
+        gb1.saturate();
+        gb4.saturate();
+        VERIFY(get_stat(gb1, "dd.solver.parallel_superposed") == 0);
+        VERIFY(get_stat(gb4, "dd.solver.parallel_superposed") > 0);
+        auto has_conflict = [](solver& gb) {
+            for (auto* e : gb.equations())
+                if (e->poly().is_val() && !e->poly().is_zero())
+                    return true;
+            return false;
+        };
+        VERIFY(has_conflict(gb1));
+        VERIFY(has_conflict(gb4));
+
+        // a consistent system, the two bases generate the same ideal
+        pdd_manager m3(n), m4(n);
+        solver gb1c(lim, m3), gb4c(lim, m4);
+        cfg.m_max_steps = UINT_MAX;
+        cfg.m_threads = 1;
+        gb1c.set(cfg);
+        cfg.m_threads = 4;
+        gb4c.set(cfg);
+        for (unsigned i = 0; i < n; ++i) {
+            pdd x = m3.mk_var(i), y = m3.mk_var((i + 1) % n), z = m3.mk_var((i + 2) % n);
+            for (pdd p : { x*y - z, x*x - x }) {
+                gb1c.add(p);
+                gb4c.add(m4.translate(p));
+            }
+        }
+        gb1c.saturate();
+        gb4c.saturate();
+        VERIFY(!has_conflict(gb1c));
+        VERIFY(!has_conflict(gb4c));
+        VERIFY(reduces_to_zero(gb1c, gb4c, m4));
+        VERIFY(reduces_to_zero(gb4c, gb1c, m3));
+    }
+
     expr_ref elim_or(ast_manager& m, expr* e) {
         obj_map<expr, expr*> cache;
         expr_ref_vector trail(m), todo(m), args(m);
@@ -232,8 +317,9 @@ namespace dd {
         ast_manager m;
         reg_decl_plugins(m);
         bv_util bv(m);
-        expr_ref x(m.mk_const("x", bv.mk_sort(3)), m);
-        expr_ref y(m.mk_const("y", bv.mk_sort(3)), m);
+        // 3-bit operands take several minutes
+        expr_ref x(m.mk_const("x", bv.mk_sort(2)), m);
+        expr_ref y(m.mk_const("y", bv.mk_sort(2)), m);
         expr_ref xy(bv.mk_bv_mul(x, y), m);
         expr_ref yx(bv.mk_bv_mul(y, x), m);
         expr_ref eq(m.mk_not(m.mk_eq(xy,yx)), m);
@@ -256,5 +342,6 @@ namespace dd {
 
 void tst_pdd_solver() {
     dd::test1();
+    dd::test3();
     dd::test2();
 }
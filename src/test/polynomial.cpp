@@ -1507,6 +1507,32 @@ static void tst_const_coeff() {
     ENSURE(!m.const_coeff(p, 0, 1, c));
 }
 
+static void tst_gcd_many_primes() {
+    // coefficients of the GCD are much larger than a single big prime,
+    // so the modular algorithms have to combine several images.
+    polynomial::numeral_manager nm;
+    reslimit rl; polynomial::manager m(rl, nm);
+    polynomial_ref x0(m);
+    polynomial_ref x1(m);
+    polynomial_ref x2(m);
+    x0 = m.mk_polynomial(m.mk_var());
+    x1 = m.mk_polynomial(m.mk_var());
+    x2 = m.mk_polynomial(m.mk_var());
+    rational a("123456789012345678901234567890123");
+    rational b("98765432109876543210987654321");
+    rational c("1000000000000000000000000000057");
+    polynomial_ref g(m);
+    polynomial_ref one(m);
+    one = m.mk_const(rational(1));
+
+    g = a*(x0^3) + b*x0 - c;
+    tst_gcd(g*(b*(x0^2) + 3), g*(c*x0 + a), g);
+
+    g = a*(x0^2)*x1 + b*x1*x2 + c*(x2^2) + 1;
+    tst_gcd(g*(c*x0 + x1 + b), g*(a*x1*x2 - x0 + 7), g);
+    tst_gcd(g*(c*x0 + x1 + b), (a*x1*x2 - x0 + 7)*(x0 + 1), one);
+}
+
 static void tst_gcd2() {
     // enable_trace("mgcd");
     polynomial::numeral_manager nm;
@@ -1821,6 +1847,7 @@ void tst_polynomial() {
     enable_trace("Lazard");
     // enable_trace("eval_bug");
     // enable_trace("mgcd");
+    tst_gcd_many_primes();
     tst_psc();
     return;
     tst_eval();
@@ -0,0 +1,119 @@
+/*++
+Copyright (c) 2020 Microsoft Corporation
+
+Module Name:
+
+    quantifier_instance_cache.cpp
+
+Abstract:
+
+    Tests for the persistent quantifier instance cache.
+
+--*/
+
+#include "ast/quantifier_instance_cache.h"
+#include "ast/arith_decl_plugin.h"
+#include "ast/reg_decl_plugins.h"
+#include "smt/smt_kernel.h"
+#include "smt/params/smt_params.h"
+
+static unsigned get_stat(statistics const & st, char const * key) {
+    for (unsigned i = 0; i < st.size(); ++i)
+        if (st.is_uint(i) && strcmp(st.get_key(i), key) == 0)
+            return st.get_uint_value(i);
+    return 0;
+}
+
+struct qi_cache_env {
+    ast_manager   m;
+    arith_util    a;
+    sort_ref      I;
+    func_decl_ref f;
+    quantifier_ref q;   // forall x . f(x) >= x
+
+    qi_cache_env(): a(m), I(m), f(m), q(m) {
+        reg_decl_plugins(m);
+        I = a.mk_int();
+        f = m.mk_func_decl(symbol("f"), I.get(), I.get());
+        expr_ref x(m.mk_var(0, I), m);
+        app_ref fx(m.mk_app(f, x.get()), m);
+        app_ref pat(m.mk_pattern(fx.get()), m);
+        expr_ref body(a.mk_ge(fx, x), m);
+        symbol name("x");
+        sort * s = I.get();
+        expr * pats[1] = { pat.get() };
+        q = m.mk_forall(1, &s, &name, body, 0, symbol::null, symbol::null, 1, pats);
+    }
+
+    app_ref mk_const(char const * n) { return app_ref(m.mk_const(symbol(n), I), m); }
+};
+
+static void tst_cache_hit_and_flush() {
+    qi_cache_env env;
+    ast_manager & m = env.m;
+    app_ref c1 = env.mk_const("c1"), c2 = env.mk_const("c2"), c3 = env.mk_const("c3");
+    expr_ref i1(env.a.mk_ge(m.mk_app(env.f, c1.get()), c1), m);
+    expr_ref i2(env.a.mk_ge(m.mk_app(env.f, c2.get()), c2), m);
+    expr_ref i3(env.a.mk_ge(m.mk_app(env.f, c3.get()), c3), m);
+    expr * b1 = c1, * b2 = c2, * b3 = c3;
+
+    q::instance_cache cache(m);
+    cache.set_max_size(2);
+
+    ENSURE(!cache.find(env.q, 1, &b1));
+    cache.insert(env.q, 1, &b1, i1);
+    ENSURE(cache.find(env.q, 1, &b1) == i1);
+    ENSURE(!cache.find(env.q, 1, &b2));
+    // inserting an existing entry does not add a second one
+    cache.insert(env.q, 1, &b1, i1);
+    ENSURE(cache.size() == 1);
+
+    cache.insert(env.q, 1, &b2, i2);
+    ENSURE(cache.size() == 2);
+    ENSURE(cache.find(env.q, 1, &b2) == i2);
+
+    // the third entry exceeds qi.instance_cache_size and flushes the cache
+    cache.insert(env.q, 1, &b3, i3);
+    ENSURE(cache.size() == 1);
+    ENSURE(cache.find(env.q, 1, &b3) == i3);
+    ENSURE(!cache.find(env.q, 1, &b1));
+    ENSURE(!cache.find(env.q, 1, &b2));
+
+    statistics st;
+    cache.collect_statistics(st);
+    ENSURE(get_stat(st, "qi cache hits") == 3);
+    ENSURE(get_stat(st, "qi cache misses") == 4);
+    ENSURE(get_stat(st, "qi cache inserts") == 3);
+    ENSURE(get_stat(st, "qi cache flushes") == 1);
+}
+
+/**
+   \brief The instance of q for a is found again after a pop, and the
+   re-pushed scope is refuted with the cached instance.
+*/
+static void tst_cache_pop_repush() {
+    qi_cache_env env;
+    ast_manager & m = env.m;
+    smt_params fp;
+    fp.m_qi_instance_cache = true;
+    smt::kernel k(m, fp);
+    k.assert_expr(env.q);
+    app_ref c = env.mk_const("c");
+    expr_ref neg(env.a.mk_lt(m.mk_app(env.f, c.get()), c), m);
+    for (unsigned round = 0; round < 3; ++round) {
+        k.push();
+        k.assert_expr(neg);
+        ENSURE(k.check() == l_false);
+        k.pop(1);
+    }
+    ENSURE(k.check() == l_true);
+    statistics st;
+    k.collect_statistics(st);
+    ENSURE(get_stat(st, "qi cache inserts") >= 1);
+    ENSURE(get_stat(st, "qi cache hits") >= 2);
+}
+
+void tst_quantifier_instance_cache() {
+    tst_cache_hit_and_flush();
+    tst_cache_pop_repush();
+}
@@ -162,10 +162,100 @@ static void tst_denominators() {
     std::cout << "---->\n" << n << "\n" << d << "\n";
 }
 
+static unsigned cache_hits(rcmanager & m) {
+    statistics st;
+    m.collect_statistics(st);
+    for (unsigned i = 0; i < st.size(); ++i)
+        if (st.is_uint(i) && strcmp(st.get_key(i), "rcf cache hits") == 0)
+            return st.get_uint_value(i);
+    return 0;
+}
+
+static void tst_cache() {
+    reslimit rl;
+    unsynch_mpq_manager qm;
+    params_ref p;
+    p.set_uint("cache_size", 0);
+    rcmanager m1(rl, qm), m2(rl, qm, p);
+    scoped_rcnumeral pi1(m1), e1(m1), pi2(m2), e2(m2);
+    m1.mk_pi(pi1); m1.mk_e(e1);
+    m2.mk_pi(pi2); m2.mk_e(e2);
+    scoped_rcnumeral_vector v1(m1), v2(m2);
+    for (int i = 1; i <= 6; i++) {
+        scoped_rcnumeral a1(m1), a2(m2);
+        a1 = pi1 * i + e1 / i;
+        a2 = pi2 * i + e2 / i;
+        v1.push_back(a1);
+        v2.push_back(a2);
+        a1 = pi1 * i + e1 / i;
+        ENSURE(m1.eq(a1, v1[v1.size() - 1]));
+    }
+    // values that are close to each other need refinement to be separated
+    scoped_mpq eps(qm);
+    qm.power(mpq(2), 40, eps);
+    qm.inv(eps);
+    scoped_rcnumeral d1(m1), d2(m2);
+    m1.set(d1, eps);
+    m2.set(d2, eps);
+    d1 = pi1 + d1;
+    d2 = pi2 + d2;
+    v1.push_back(pi1);
+    v2.push_back(pi2);
+    v1.push_back(d1);
+    v2.push_back(d2);
+    ENSURE(m1.lt(pi1, d1));
+    unsigned hits = cache_hits(m1);
+    for (unsigned k = 0; k < 2; ++k) 
+        for (unsigned i = 0; i < v1.size(); ++i) 
+            for (unsigned j = 0; j < v1.size(); ++j) 
+                ENSURE(m1.compare(v1[i], v1[j]) == m2.compare(v2[i], v2[j]));
+    // the second round compares the same numbers again
+    ENSURE(cache_hits(m1) > hits);
+    ENSURE(cache_hits(m2) == 0);
+
+    // operations on the same operands hit the cache
+    scoped_rcnumeral three1(m1), three2(m2), r1(m1), r2(m2), s1(m1), s2(m2);
+    m1.set(three1, 3);
+    m2.set(three2, 3);
+    for (unsigned k = 0; k < 3; ++k) {
+        hits = cache_hits(m1);
+        m1.mul(pi1, three1, r1);
+        m1.add(r1, e1, s1);
+        m1.div(s1, e1, s1);
+        m1.sub(s1, pi1, s1);
+        m2.mul(pi2, three2, r2);
+        m2.add(r2, e2, s2);
+        m2.div(s2, e2, s2);
+        m2.sub(s2, pi2, s2);
+        ENSURE(m1.compare(r1, s1) == m2.compare(r2, s2));
+        // the results of the first round are returned again
+        ENSURE(k == 0 || cache_hits(m1) > hits);
+    }
+
+    // a cached number is not changed by operations on numbers that shared it
+    scoped_rcnumeral a(m1), a0(m1), c(m1), c0(m1);
+    a = pi1 + e1;
+    a0 = a;
+    m1.mul(a, e1, c0);
+    m1.add(a, pi1, a);
+    m1.mul(a, three1, a);
+    hits = cache_hits(m1);
+    m1.mul(a0, e1, c);
+    ENSURE(cache_hits(m1) == hits + 1);
+    ENSURE(m1.eq(c, c0));
+    m1.mul(a, e1, c);
+    ENSURE(!m1.eq(c, c0));
+    scoped_rcnumeral b(m2), d(m2);
+    b = pi2 + e2;
+    m2.mul(b, e2, d);
+    ENSURE(m1.compare(c0, pi1) == m2.compare(d, pi2));
+}
+
 void tst_rcf() {
     enable_trace("rcf_clean");
     enable_trace("rcf_clean_bug");
     tst_denominators();
+    tst_cache();
     tst1();
     tst2();
     { int A[] = {0, 1, 1, 1, 0, 1, 1, 1, -1}; int c[] = {10, 4, -4}; int b[] = {-2, 4, 6}; tst_solve(3, A, b, c, true); }
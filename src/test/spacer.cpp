@@ -0,0 +1,109 @@
+/*++
+Copyright (c) 2020 Microsoft Corporation
+
+Module Name:
+
+    spacer.cpp
+
+Abstract:
+
+    Compare Spacer with helper instances (spacer.threads > 1) and with
+    spacer.batch_push against the default configuration.
+
+--*/
+
+#include "api/z3.h"
+#include "util/util.h"
+#include <cstring>
+#include <string>
+
+static unsigned get_stat(Z3_context ctx, Z3_stats st, char const * key) {
+    for (unsigned i = 0; i < Z3_stats_size(ctx, st); ++i)
+        if (Z3_stats_is_uint(ctx, st, i) && strcmp(Z3_stats_get_key(ctx, st, i), key) == 0)
+            return Z3_stats_get_uint_value(ctx, st, i);
+    return 0;
+}
+
+typedef void (*set_params_fn)(Z3_context, Z3_params);
+
+// run the only query of the benchmark and add the value of stat to stat_value.
+static Z3_lbool query_spacer(char const * benchmark, set_params_fn set_params, char const * stat, unsigned & stat_value) {
+    Z3_config cfg = Z3_mk_config();
+    Z3_context ctx = Z3_mk_context(cfg);
+    Z3_del_config(cfg);
+    Z3_fixedpoint fp = Z3_mk_fixedpoint(ctx);
+    Z3_fixedpoint_inc_ref(ctx, fp);
+    Z3_params p = Z3_mk_params(ctx);
+    Z3_params_inc_ref(ctx, p);
+    Z3_params_set_symbol(ctx, p, Z3_mk_string_symbol(ctx, "engine"), Z3_mk_string_symbol(ctx, "spacer"));
+    set_params(ctx, p);
+    Z3_fixedpoint_set_params(ctx, fp, p);
+    Z3_ast_vector queries = Z3_fixedpoint_from_string(ctx, fp, benchmark);
+    Z3_ast_vector_inc_ref(ctx, queries);
+    ENSURE(Z3_ast_vector_size(ctx, queries) == 1);
+    Z3_lbool r = Z3_fixedpoint_query(ctx, fp, Z3_ast_vector_get(ctx, queries, 0));
+    Z3_stats st = Z3_fixedpoint_get_statistics(ctx, fp);
+    Z3_stats_inc_ref(ctx, st);
+    stat_value += get_stat(ctx, st, stat);
+    Z3_stats_dec_ref(ctx, st);
+    Z3_ast_vector_dec_ref(ctx, queries);
+    Z3_params_dec_ref(ctx, p);
+    Z3_fixedpoint_dec_ref(ctx, fp);
+    Z3_del_context(ctx);
+    return r;
+}
+
+static void set_sequential(Z3_context ctx, Z3_params p) {
+    Z3_params_set_uint(ctx, p, Z3_mk_string_symbol(ctx, "spacer.threads"), 1);
+}
+
+static void set_threads(Z3_context ctx, Z3_params p) {
+    Z3_params_set_uint(ctx, p, Z3_mk_string_symbol(ctx, "spacer.threads"), 3);
+}
+
+static char const * s_counters =
+    "(declare-rel inv (Int Int Int))\n"
+    "(declare-rel fail ())\n"
+    "(declare-var x Int)\n"
+    "(declare-var y Int)\n"
+    "(declare-var z Int)\n"
+    "(declare-var x1 Int)\n"
+    "(declare-var y1 Int)\n"
+    "(declare-var z1 Int)\n"
+    "(rule (=> (and (= x 0) (= y 0) (= z 0)) (inv x y z)))\n"
+    "(rule (=> (and (inv x y z) (< x 12) (= x1 (+ x 1)) (= y1 (+ y 2)) (= z1 (+ z x))) (inv x1 y1 z1)))\n";
+
+static void tst_spacer_threads() {
+    std::string safe = std::string(s_counters) + "(rule (=> (and (inv x y z) (> y 24)) fail))\n(query fail)\n";
+    std::string unsafe = std::string(s_counters) + "(rule (=> (and (inv x y z) (= x 12) (= y 24)) fail))\n(query fail)\n";
+    unsigned num_imported = 0, num_seq_imported = 0;
+    for (std::string const & b : { safe, unsafe }) {
+        Z3_lbool seq = query_spacer(b.c_str(), set_sequential, "SPACER num imported lemmas", num_seq_imported);
+        ENSURE(seq != Z3_L_UNDEF);
+        ENSURE(query_spacer(b.c_str(), set_threads, "SPACER num imported lemmas", num_imported) == seq);
+    }
+    ENSURE(num_seq_imported == 0);
+    // the main instance used lemmas of the helpers
+    ENSURE(num_imported > 0);
+}
+
+static void set_batch_push(Z3_context ctx, Z3_params p) {
+    Z3_params_set_bool(ctx, p, Z3_mk_string_symbol(ctx, "spacer.batch_push"), true);
+}
+
+static void tst_spacer_batch_push() {
+    std::string safe = std::string(s_counters) + "(rule (=> (and (inv x y z) (> y 24)) fail))\n(query fail)\n";
+    std::string unsafe = std::string(s_counters) + "(rule (=> (and (inv x y z) (= x 12) (= y 24)) fail))\n(query fail)\n";
+    unsigned num_batch = 0, num_seq_batch = 0;
+    for (std::string const & b : { safe, unsafe }) {
+        Z3_lbool seq = query_spacer(b.c_str(), set_sequential, "SPACER num batch push", num_seq_batch);
+        ENSURE(query_spacer(b.c_str(), set_batch_push, "SPACER num batch push", num_batch) == seq);
+    }
+    ENSURE(num_seq_batch == 0);
+    ENSURE(num_batch > 0);
+}
+
+void tst_spacer() {
+    tst_spacer_threads();
+    tst_spacer_batch_push();
+}
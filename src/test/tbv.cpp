@@ -5,6 +5,7 @@ Copyright (c) 2015 Microsoft Corporation
 --*/
 
 #include "muz/rel/tbv.h"
+#include "util/stopwatch.h"
 
 static void tst1(unsigned num_bits) {
     tbv_manager m(num_bits);
@@ -74,6 +75,66 @@ static void tst2(unsigned num_bits) {
     }
 }
 
+static tbv* mk_random(tbv_manager& m, random_gen& rand) {
+    tbv* t = m.allocateX();
+    for (unsigned i = 0; i < m.num_tbits(); ++i) {
+        switch (rand(16)) {
+        case 0: m.set(*t, i, BIT_0); break;
+        case 1: m.set(*t, i, BIT_1); break;
+        case 2: if (rand(8) == 0) m.set(*t, i, BIT_z); break;
+        default: break;
+        }
+    }
+    return t;
+}
+
+// compare the SIMD kernels with the scalar ones and time both.
+static void tst_kernels(unsigned num_bits, unsigned num_tbvs, unsigned num_rounds) {
+    tbv_manager m(num_bits);
+    random_gen rand(num_bits);
+    ptr_vector<tbv> tbvs;
+    for (unsigned i = 0; i < num_tbvs; ++i) {
+        tbvs.push_back(mk_random(m, rand));
+        if (rand(4) == 0) tbvs.push_back(m.allocate(*tbvs.back()));
+    }
+    tbv_ref r1(m, m.allocate()), r2(m, m.allocate());
+    for (tbv* a : tbvs) {
+        for (tbv* b : tbvs) {
+            m.set_simd(false);
+            m.copy(*r1, *a);
+            bool meet1 = m.set_and(*r1, *b);
+            bool eq1 = m.equals(*a, *b), sub1 = m.contains(*a, *b), wf1 = m.is_well_formed(*a);
+            m.set_simd(true);
+            m.copy(*r2, *a);
+            bool meet2 = m.set_and(*r2, *b);
+            ENSURE(meet1 == meet2);
+            ENSURE(m.equals(*r1, *r2));
+            ENSURE(eq1 == m.equals(*a, *b));
+            ENSURE(sub1 == m.contains(*a, *b));
+            ENSURE(wf1 == m.is_well_formed(*a));
+        }
+    }
+    for (unsigned simd = 0; simd < 2; ++simd) {
+        m.set_simd(simd != 0);
+        stopwatch sw;
+        sw.start();
+        unsigned n = 0;
+        for (unsigned k = 0; k < num_rounds; ++k) {
+            for (tbv* a : tbvs) {
+                for (tbv* b : tbvs) {
+                    n += m.intersect(*a, *b, *r1);
+                    n += m.contains(*a, *b);
+                    n += m.equals(*a, *b);
+                }
+            }
+        }
+        sw.stop();
+        std::cout << num_bits << " bits " << m.kernels_name() << ": " << n << " " << sw.get_seconds() << "s\n";
+    }
+    for (tbv* t : tbvs)
+        m.deallocate(t);
+}
+
 #if 0
 // prints all don't care pareto fronts for 8-bit multiplier.
 static void test_dc() {
@@ -150,4 +211,9 @@ void tst_tbv() {
     tst2(15);
     tst2(16);
     tst2(17);
+
+    tst_kernels(17, 40, 1);
+    tst_kernels(64, 40, 1);
+    tst_kernels(300, 60, 10);
+    tst_kernels(1000, 60, 10);
 }
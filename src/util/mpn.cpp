@@ -102,18 +102,68 @@ bool mpn_manager::sub(mpn_digit const * a, size_t const lnga,
     return true; // return k != 0?
 }
 
+#define DIGIT_BITS (sizeof(mpn_digit)*8)
+#define HALF_BITS (sizeof(mpn_digit)*4)
+
+// Operands with fewer digits than this are multiplied with the schoolbook method.
+#define KARATSUBA_THRESHOLD 32
+
+// c[0..lngc) += a[0..lnga); the result must fit into lngc digits.
+static void add_in_place(mpn_digit * c, size_t lngc, mpn_digit const * a, size_t lnga) {
+    SASSERT(lnga <= lngc);
+    mpn_digit k = 0;
+    size_t j = 0;
+    for (; j < lnga; j++) {
+        mpn_digit r = c[j] + a[j];
+        bool c1 = r < a[j];
+        c[j] = r + k;
+        k = c1 | (c[j] < r);
+    }
+    for (; k && j < lngc; j++) {
+        c[j]++;
+        k = c[j] == 0;
+    }
+    SASSERT(k == 0);
+}
+
+// c[0..lngc) -= a[0..lnga); the result must be non-negative.
+static void sub_in_place(mpn_digit * c, size_t lngc, mpn_digit const * a, size_t lnga) {
+    SASSERT(lnga <= lngc);
+    mpn_digit k = 0;
+    size_t j = 0;
+    for (; j < lnga; j++) {
+        mpn_digit r = c[j] - a[j];
+        bool c1 = r > c[j];
+        mpn_digit t = r - k;
+        k = c1 | (t > r);
+        c[j] = t;
+    }
+    for (; k && j < lngc; j++) {
+        k = c[j] == 0;
+        c[j]--;
+    }
+    SASSERT(k == 0);
+}
+
 bool mpn_manager::mul(mpn_digit const * a, size_t const lnga,
                       mpn_digit const * b, size_t const lngb,
                       mpn_digit * c) const {
     trace(a, lnga, b, lngb, "*");
-    // Essentially Knuth's Algorithm M. 
-    // Perhaps implement a more efficient version, see e.g., Knuth, Section 4.3.3.    
+    if (lnga < KARATSUBA_THRESHOLD || lngb < KARATSUBA_THRESHOLD)
+        mul_basecase(a, lnga, b, lngb, c);
+    else
+        mul_karatsuba(a, lnga, b, lngb, c);
+    trace_nl(c, lnga+lngb);
+    return true;
+}
+
+void mpn_manager::mul_basecase(mpn_digit const * a, size_t const lnga,
+                               mpn_digit const * b, size_t const lngb,
+                               mpn_digit * c) const {
+    // Essentially Knuth's Algorithm M.
     size_t i;
     mpn_digit k;
 
-#define DIGIT_BITS (sizeof(mpn_digit)*8)
-#define HALF_BITS (sizeof(mpn_digit)*4)
-
     for (unsigned i = 0; i < lnga; i++)
         c[i] = 0;
 
@@ -137,9 +187,58 @@ bool mpn_manager::mul(mpn_digit const * a, size_t const lnga,
             c[j+lnga] = k;
         }        
     }
-    
-    trace_nl(c, lnga+lngb);
-    return true;
+}
+
+/**
+   Karatsuba multiplication, see Knuth, Section 4.3.3.
+   Write a = a1*B^h + a0 and b = b1*B^h + b0, then
+   a*b = z2*B^2h + (z1 - z2 - z0)*B^h + z0
+   where z0 = a0*b0, z2 = a1*b1 and z1 = (a0 + a1)*(b0 + b1).
+   Unbalanced operands are split into chunks of the length of the shorter one.
+ */
+void mpn_manager::mul_karatsuba(mpn_digit const * a, size_t lnga,
+                                mpn_digit const * b, size_t lngb,
+                                mpn_digit * c) const {
+    if (lnga < lngb) {
+        std::swap(a, b);
+        std::swap(lnga, lngb);
+    }
+    if (lngb < KARATSUBA_THRESHOLD) {
+        mul_basecase(a, lnga, b, lngb, c);
+        return;
+    }
+    size_t const lngc = lnga + lngb;
+    if (2 * lngb <= lnga) {
+        for (size_t i = 0; i < lngc; i++)
+            c[i] = 0;
+        mpn_sbuffer t(2 * lngb, 0);
+        for (size_t i = 0; i < lnga; i += lngb) {
+            size_t l = std::min(lngb, lnga - i);
+            mul_karatsuba(a + i, l, b, lngb, t.data());
+            add_in_place(c + i, lngc - i, t.data(), l + lngb);
+        }
+        return;
+    }
+
+    size_t const h = lnga / 2;
+    size_t const la1 = lnga - h, lb1 = lngb - h;
+    SASSERT(lb1 > 0 && la1 >= h);
+    mul_karatsuba(a, h, b, h, c);
+    mul_karatsuba(a + h, la1, b + h, lb1, c + 2 * h);
+
+    size_t const ls = la1 + 1, lt = max(h, lb1) + 1;
+    mpn_sbuffer sa(ls, 0), sb(lt, 0), z1(ls + lt, 0);
+    for (size_t i = 0; i < h; i++) sa[i] = a[i];
+    add_in_place(sa.data(), ls, a + h, la1);
+    for (size_t i = 0; i < h; i++) sb[i] = b[i];
+    add_in_place(sb.data(), lt, b + h, lb1);
+    mul_karatsuba(sa.data(), ls, sb.data(), lt, z1.data());
+    sub_in_place(z1.data(), ls + lt, c, 2 * h);
+    sub_in_place(z1.data(), ls + lt, c + 2 * h, la1 + lb1);
+    size_t lz = ls + lt;
+    while (lz > 0 && z1[lz - 1] == 0)
+        lz--;
+    add_in_place(c + h, lngc - h, z1.data(), lz);
 }
 
 #define MASK_FIRST (~((mpn_digit)(-1) >> 1))
@@ -183,12 +282,12 @@ bool mpn_manager::div(mpn_digit const * numer, size_t const lnum,
             rem[i] = (i < lnum) ? numer[i] : 0;       
     }        
     else  {
-        mpn_sbuffer u, v, t_ms, t_ab;
+        mpn_sbuffer u, v, t_ab;
         size_t d = div_normalize(numer, lnum, denom, lden, u, v);
         if (lden == 1)
             res = div_1(u, v[0], quot);
         else
-            res = div_n(u, v, quot, rem, t_ms, t_ab);
+            res = div_n(u, v, quot, rem, t_ab);
         div_unnormalize(u, v, d, rem);    
     }
 
@@ -302,7 +401,7 @@ bool mpn_manager::div_1(mpn_sbuffer & numer, mpn_digit const denom,
 
 bool mpn_manager::div_n(mpn_sbuffer & numer, mpn_sbuffer const & denom,
                         mpn_digit * quot, mpn_digit * rem,
-                        mpn_sbuffer & ms, mpn_sbuffer & ab) const {
+                        mpn_sbuffer & ab) const {
     SASSERT(denom.size() > 1);
 
     // This is essentially Knuth's Algorithm D.
@@ -311,8 +410,6 @@ bool mpn_manager::div_n(mpn_sbuffer & numer, mpn_sbuffer const & denom,
 
     SASSERT(numer.size() == m+n);
 
-    ms.resize(n+1);
-    
     mpn_double_digit q_hat, temp, r_hat;
     mpn_digit borrow;
 
@@ -330,9 +427,25 @@ bool mpn_manager::div_n(mpn_sbuffer & numer, mpn_sbuffer const & denom,
         SASSERT(q_hat < BASE);        
         // Replace numer[j+n]...numer[j] with 
         // numer[j+n]...numer[j] - q * (denom[n-1]...denom[0])
+        // The product and the subtraction are fused into one pass.
         mpn_digit q_hat_small = (mpn_digit)q_hat;
-        mul(&q_hat_small, 1, denom.data(), n, ms.data());
-        sub(&numer[j], n+1, ms.data(), n+1, &numer[j], &borrow);
+        mpn_digit carry = 0;
+        borrow = 0;
+        for (size_t i = 0; i <= n; i++) {
+            mpn_digit p_i;
+            if (i < n) {
+                mpn_double_digit p = (mpn_double_digit)q_hat_small * denom[i] + carry;
+                p_i = (mpn_digit)p;
+                carry = (mpn_digit)(p >> DIGIT_BITS);
+            }
+            else
+                p_i = carry;
+            mpn_digit r = numer[j+i] - p_i;
+            bool c1 = r > numer[j+i];
+            mpn_digit t = r - borrow;
+            borrow = c1 | (t > r);
+            numer[j+i] = t;
+        }
         quot[j] = q_hat_small;
         if (borrow) {
             quot[j]--;
@@ -343,7 +456,6 @@ bool mpn_manager::div_n(mpn_sbuffer & numer, mpn_sbuffer const & denom,
                 numer[j+i] = ab[i];
         }
         TRACE("mpn_div", tout << "q_hat=" << q_hat << " r_hat=" << r_hat;
-                         tout << " ms="; display_raw(tout, ms.data(), n);
                          tout << " new numer="; display_raw(tout, numer.data(), m+n+1);
                          tout << " borrow=" << borrow;
                          tout << std::endl; );
@@ -368,17 +480,25 @@ char * mpn_manager::to_string(mpn_digit const * a, size_t const lng, char * buf,
         for (unsigned i = 0; i < lng; i++)
             temp[i] = a[i];
     
+        // Peel off 9 decimal digits per division.
         size_t j = 0;
         mpn_digit rem;
-        mpn_digit ten = 10;        
-        while (!temp.empty() && (temp.size() > 1 || temp[0] != 0)) {
-            size_t d = div_normalize(&temp[0], temp.size(), &ten, 1, t_numer, t_denom);
+        mpn_digit const chunk = 1000000000;
+        while (!temp.empty() && temp.back() == 0)
+            temp.pop_back();
+        while (!temp.empty()) {
+            size_t d = div_normalize(&temp[0], temp.size(), &chunk, 1, t_numer, t_denom);
             div_1(t_numer, t_denom[0], &temp[0]);
             div_unnormalize(t_numer, t_denom, d, &rem);
-            buf[j++] = '0' + rem;
             while (!temp.empty() && temp.back() == 0)
                 temp.pop_back();
+            for (unsigned i = 0; i < 9 && j < lbuf - 1 && (rem != 0 || !temp.empty()); i++) {
+                buf[j++] = '0' + (rem % 10);
+                rem /= 10;
+            }
         }
+        if (j == 0)
+            buf[j++] = '0';
         buf[j] = 0;
 
         j--;
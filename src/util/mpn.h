@@ -95,7 +95,15 @@ private:
 
     bool div_n(mpn_sbuffer & numer, mpn_sbuffer const & denom,
                mpn_digit * quot, mpn_digit * rem,
-               mpn_sbuffer & ms, mpn_sbuffer & ab) const;
+               mpn_sbuffer & ab) const;
+
+    void mul_basecase(mpn_digit const * a, size_t lnga,
+                      mpn_digit const * b, size_t lngb,
+                      mpn_digit * c) const;
+
+    void mul_karatsuba(mpn_digit const * a, size_t lnga,
+                       mpn_digit const * b, size_t lngb,
+                       mpn_digit * c) const;
 
     void trace(mpn_digit const * a, size_t lnga,
                mpn_digit const * b, size_t lngb,
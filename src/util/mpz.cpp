@@ -128,7 +128,6 @@ mpz_manager<SYNCH>::mpz_manager():
     else {
         m_init_cell_capacity = 6;
     }
-    set(m_int_min, -static_cast<int64_t>(INT_MIN));
 #else
     // GMP
     mpz_init(m_tmp);
@@ -166,9 +165,7 @@ mpz_manager<SYNCH>::mpz_manager():
 template<bool SYNCH>
 mpz_manager<SYNCH>::~mpz_manager() {
     del(m_two64);
-#ifndef _MP_GMP
-    del(m_int_min);
-#else
+#ifdef _MP_GMP
     mpz_clear(m_tmp);
     mpz_clear(m_tmp2);
     mpz_clear(m_two32);
@@ -179,6 +176,64 @@ mpz_manager<SYNCH>::~mpz_manager() {
 }
 
 #ifndef _MP_GMP
+
+#if !defined(SINGLE_THREAD) && (defined(_WINDOWS) || defined(_USE_THREAD_LOCAL))
+#define MPZ_CELL_CACHE
+
+/**
+   \brief Per-thread free lists of small digit cells used by the synchronized managers.
+
+   Numerals owned by the global rational manager, such as the tableau entries
+   of the arithmetic solvers, repeatedly leave and re-enter the small range
+   while pivoting. Recycling their cells avoids a round trip through the
+   global allocator for each of them.
+   A free cell stores the next cell of its list in its first word.
+
+   Cached cells remain allocated for the memory manager, so they count against
+   the memory limit. At most max_bytes are kept per thread.
+*/
+class mpz_cell_cache {
+    static const unsigned max_capacity = 16;
+    static const size_t   max_bytes    = 64 * 1024;
+    void *   m_head[max_capacity + 1];
+    size_t   m_bytes;
+public:
+    mpz_cell_cache(): m_bytes(0) {
+        memset(m_head, 0, sizeof(m_head));
+    }
+
+    ~mpz_cell_cache() {
+        for (void * p : m_head) {
+            while (p) {
+                void * next = *static_cast<void**>(p);
+                memory::deallocate(p);
+                p = next;
+            }
+        }
+    }
+
+    void * pop(unsigned capacity, size_t sz) {
+        if (capacity > max_capacity || !m_head[capacity])
+            return nullptr;
+        void * p = m_head[capacity];
+        m_head[capacity] = *static_cast<void**>(p);
+        m_bytes -= sz;
+        return p;
+    }
+
+    bool push(unsigned capacity, size_t sz, void * p) {
+        if (capacity > max_capacity || m_bytes + sz > max_bytes)
+            return false;
+        *static_cast<void**>(p) = m_head[capacity];
+        m_head[capacity] = p;
+        m_bytes += sz;
+        return true;
+    }
+};
+
+static thread_local mpz_cell_cache g_mpz_cell_cache;
+#endif
+
 template<bool SYNCH>
 mpz_cell * mpz_manager<SYNCH>::allocate(unsigned capacity) {
     SASSERT(capacity >= m_init_cell_capacity);
@@ -187,7 +242,13 @@ mpz_cell * mpz_manager<SYNCH>::allocate(unsigned capacity) {
     cell = reinterpret_cast<mpz_cell*>(m_allocator.allocate(cell_size(capacity)));
 #else
     if (SYNCH) {
+#ifdef MPZ_CELL_CACHE
+        cell = reinterpret_cast<mpz_cell*>(g_mpz_cell_cache.pop(capacity, cell_size(capacity)));
+        if (!cell)
+            cell = reinterpret_cast<mpz_cell*>(memory::allocate(cell_size(capacity)));
+#else
         cell = reinterpret_cast<mpz_cell*>(memory::allocate(cell_size(capacity)));
+#endif
     }
     else {
         cell = reinterpret_cast<mpz_cell*>(m_allocator.allocate(cell_size(capacity)));
@@ -206,6 +267,10 @@ void mpz_manager<SYNCH>::deallocate(bool is_heap, mpz_cell * ptr) {
         m_allocator.deallocate(cell_size(ptr->m_capacity), ptr); 
 #else
         if (SYNCH) {
+#ifdef MPZ_CELL_CACHE
+            if (g_mpz_cell_cache.push(ptr->m_capacity, cell_size(ptr->m_capacity), ptr))
+                return;
+#endif
             memory::deallocate(ptr);
         }
         else {
@@ -369,7 +434,17 @@ mpz_manager<SYNCH>::ensure_mpz_t::ensure_mpz_t(mpz const& a) {
     if (is_small(a)) {
         m_result = &m_local;
         mpz_init(m_local);
-        mpz_set_si(m_local, a.m_val);
+        if (sizeof(long) >= sizeof(int64_t) || (LONG_MIN <= a.m_val && a.m_val <= LONG_MAX)) {
+            mpz_set_si(m_local, static_cast<long>(a.m_val));
+        }
+        else {
+            uint64_t u = a.m_val < 0 ? -a.m_val : a.m_val;
+            mpz_set_ui(m_local, static_cast<unsigned long>(u >> 32));
+            mpz_mul_2exp(m_local, m_local, 32);
+            mpz_add_ui(m_local, m_local, static_cast<unsigned long>(u & 0xFFFFFFFFull));
+            if (a.m_val < 0)
+                mpz_neg(m_local, m_local);
+        }
     }
     else {
         m_result = a.m_ptr;
@@ -397,10 +472,10 @@ void mpz_manager<SYNCH>::set(mpz_cell& src, mpz & a, int sign, unsigned sz) {
         return;
     }
     
-    unsigned d = src.m_digits[0];
-    if (i == 1 && d <= INT_MAX) {
+    int64_t d;
+    if (is_small_digits(i, src.m_digits, d)) {
         // src fits is a fixnum
-        a.m_val = sign < 0 ? -static_cast<int>(d) : static_cast<int>(d);
+        a.m_val = sign < 0 ? -d : d;
         a.m_kind = mpz_small;
         return;
     }
@@ -445,6 +520,8 @@ void mpz_manager<SYNCH>::set_digits(mpz & target, unsigned sz, digit_t const * d
         set(target, 0);
     else if (sz == 1)
         set(target, digits[0]);
+    else if (sz == 2 && sizeof(digit_t) < sizeof(uint64_t))
+        set(target, static_cast<uint64_t>(digits[0]) | (static_cast<uint64_t>(digits[1]) << 32));
     else {
 #ifndef _MP_GMP
         target.m_val = 1; // number is positive.
@@ -496,8 +573,9 @@ void mpz_manager<SYNCH>::set_digits(mpz & target, unsigned sz, digit_t const * d
 template<bool SYNCH>
 void mpz_manager<SYNCH>::mul(mpz const & a, mpz const & b, mpz & c) {
     STRACE("mpz", tout << "[mpz] " << to_string(a) << " * " << to_string(b) << " == ";); 
-    if (is_small(a) && is_small(b)) {
-        set_i64(c, i64(a) * i64(b));
+    int64_t r;
+    if (is_small(a) && is_small(b) && mul_i64(i64(a), i64(b), r)) {
+        set_i64(c, r);
     }
     else {
         big_mul(a, b, c);
@@ -639,11 +717,6 @@ void mpz_manager<SYNCH>::mod(mpz const & a, mpz const & b, mpz & c) {
 template<bool SYNCH>
 void mpz_manager<SYNCH>::neg(mpz & a) {
     STRACE("mpz", tout << "[mpz] 0 - " << to_string(a) << " == ";); 
-    if (is_small(a) && a.m_val == INT_MIN) {
-        // neg(INT_MIN) is not a small int
-        set_big_i64(a, - static_cast<long long>(INT_MIN)); 
-        return;
-    }
 #ifndef _MP_GMP
     a.m_val = -a.m_val;
 #else
@@ -660,14 +733,8 @@ void mpz_manager<SYNCH>::neg(mpz & a) {
 template<bool SYNCH>
 void mpz_manager<SYNCH>::abs(mpz & a) {
     if (is_small(a)) {
-        if (a.m_val < 0) {
-            if (a.m_val == INT_MIN) {
-                // abs(INT_MIN) is not a small int
-                set_big_i64(a, - static_cast<long long>(INT_MIN)); 
-            }
-            else
-                a.m_val = -a.m_val;
-        }
+        if (a.m_val < 0) 
+            a.m_val = -a.m_val;
     }
     else {
 #ifndef _MP_GMP
@@ -870,15 +937,15 @@ void mpz_manager<SYNCH>::big_rem(mpz const & a, mpz const & b, mpz & c) {
 
 template<bool SYNCH>
 void mpz_manager<SYNCH>::gcd(mpz const & a, mpz const & b, mpz & c) {
-    static_assert(sizeof(a.m_val) == sizeof(int), "size mismatch");
     static_assert(sizeof(mpz) <= 16, "mpz size overflow");
-    if (is_small(a) && is_small(b) && a.m_val != INT_MIN && b.m_val != INT_MIN) {
-        int _a = a.m_val;
-        int _b = b.m_val;
-        if (_a < 0) _a = -_a;
-        if (_b < 0) _b = -_b;
-        unsigned r = u_gcd(_a, _b);
-        set(c, r);
+    if (is_small(a) && is_small(b)) {
+        uint64_t _a = a.m_val < 0 ? -a.m_val : a.m_val;
+        uint64_t _b = b.m_val < 0 ? -b.m_val : b.m_val;
+        // u_gcd takes the minimum using the sign bit of a difference
+        if ((_a | _b) <= INT_MAX) 
+            set(c, u_gcd(static_cast<unsigned>(_a), static_cast<unsigned>(_b)));
+        else
+            set(c, u64_gcd(_a, _b));
     }
     else {
 #ifdef _MP_GMP
@@ -1048,8 +1115,7 @@ void mpz_manager<SYNCH>::gcd(mpz const & a, mpz const & b, mpz & c) {
             SASSERT(ge(a1, b1));
             if (is_small(b1)) {
                 if (is_small(a1)) {
-                    unsigned r = u_gcd(a1.m_val, b1.m_val);
-                    set(c, r);
+                    set(c, u64_gcd(a1.m_val, b1.m_val));
                     break;
                 }
                 else {
@@ -1842,7 +1908,7 @@ std::string mpz_manager<SYNCH>::to_string(mpz const & a) const {
 template<bool SYNCH>
 unsigned mpz_manager<SYNCH>::hash(mpz const & a) {
     if (is_small(a))
-        return a.m_val;
+        return static_cast<unsigned>(a.m_val);
 #ifndef _MP_GMP
     unsigned sz = size(a);
     if (sz == 1)
@@ -1865,8 +1931,8 @@ void mpz_manager<SYNCH>::power(mpz const & a, unsigned p, mpz & b) {
 #ifndef _MP_GMP
     if (is_small(a)) {
         if (a.m_val == 2) {
-            if (p < 8 * sizeof(int) - 1) {
-                b.m_val = 1 << p;
+            if (p < 61) {
+                b.m_val = static_cast<int64_t>(1) << p;
                 b.m_kind = mpz_small;
             }
             else {
@@ -1920,8 +1986,9 @@ bool mpz_manager<SYNCH>::is_power_of_two(mpz const & a, unsigned & shift) {
     if (is_nonpos(a))
         return false;
     if (is_small(a)) {
-        if (::is_power_of_two(a.m_val)) {
-            shift = ::log2((unsigned)a.m_val);
+        uint64_t v = a.m_val;
+        if (!(v & (v - 1))) {
+            shift = uint64_log2(v);
             return true;
         }
         else {
@@ -1965,27 +2032,12 @@ void mpz_manager<SYNCH>::ensure_capacity(mpz & a, unsigned capacity) {
         capacity = m_init_cell_capacity;
     
     if (is_small(a)) {
-        int val = a.m_val;
+        int64_t val = a.m_val;
         allocate_if_needed(a, capacity);
         a.m_kind = mpz_large;
         SASSERT(a.m_ptr->m_capacity >= capacity);
-        if (val == INT_MIN) {
-            unsigned intmin_sz = m_int_min.m_ptr->m_size;
-            for (unsigned i = 0; i < intmin_sz; i++)
-                a.m_ptr->m_digits[i] = m_int_min.m_ptr->m_digits[i];
-            a.m_val = -1;
-            a.m_ptr->m_size = m_int_min.m_ptr->m_size;
-        }
-        else if (val < 0) {
-            a.m_ptr->m_digits[0] = -val;
-            a.m_val = -1;
-            a.m_ptr->m_size = 1;
-        }
-        else {
-            a.m_ptr->m_digits[0] =  val;
-            a.m_val = 1;
-            a.m_ptr->m_size = 1;
-        }
+        a.m_ptr->m_size = small_digits(val, a.m_ptr->m_digits);
+        a.m_val = val < 0 ? -1 : 1;
     }
     else if (a.m_ptr->m_capacity < capacity) {
         mpz_cell * new_cell = allocate(capacity);
@@ -2017,10 +2069,10 @@ void mpz_manager<SYNCH>::normalize(mpz & a) {
         return;
     }
     
-    if (i == 1 && ds[0] <= INT_MAX) {
+    int64_t val;
+    if (is_small_digits(i, ds, val)) {
         // a is small
-        int val = a.m_val < 0 ? -static_cast<int>(ds[0]) : static_cast<int>(ds[0]);
-        a.m_val = val;
+        a.m_val = a.m_val < 0 ? -val : val;
         a.m_kind = mpz_small;
         return;
     }
@@ -2034,14 +2086,10 @@ void mpz_manager<SYNCH>::machine_div2k(mpz & a, unsigned k) {
     if (k == 0 || is_zero(a))
         return;
     if (is_small(a)) {
-        if (k < 32) {
-            int64_t twok = 1ull << ((int64_t)k);
-            int64_t val = a.m_val;
-            a.m_val = (int)(val/twok);
-        }
-        else {
+        if (k < 62) 
+            a.m_val = a.m_val / (static_cast<int64_t>(1) << k);
+        else 
             a.m_val = 0;
-        }
         return;
     }
 #ifndef _MP_GMP
@@ -2103,15 +2151,16 @@ template<bool SYNCH>
 void mpz_manager<SYNCH>::mul2k(mpz & a, unsigned k) {
     if (k == 0 || is_zero(a))
         return;
-    if (is_small(a) && k < 32) {
-        set_i64(a, i64(a) * (static_cast<int64_t>(1) << k));
+    int64_t r;
+    if (is_small(a) && k < 62 && mul_i64(i64(a), static_cast<int64_t>(1) << k, r)) {
+        set_i64(a, r);
         return;
     }
 #ifndef _MP_GMP
     TRACE("mpz_mul2k", tout << "mul2k\na: " << to_string(a) << "\nk: " << k << "\n";);
     unsigned word_shift  = k / (8 * sizeof(digit_t));
     unsigned bit_shift   = k % (8 * sizeof(digit_t));
-    unsigned old_sz      = is_small(a) ? 1 : a.m_ptr->m_size;
+    unsigned old_sz      = is_small(a) ? sizeof(uint64_t) / sizeof(digit_t) : a.m_ptr->m_size;
     unsigned new_sz      = old_sz + word_shift + 1;
     ensure_capacity(a, new_sz);
     TRACE("mpz_mul2k", tout << "word_shift: " << word_shift << "\nbit_shift: " << bit_shift << "\nold_sz: " << old_sz << "\nnew_sz: " << new_sz 
@@ -2169,9 +2218,8 @@ template<bool SYNCH>
 unsigned mpz_manager<SYNCH>::power_of_two_multiple(mpz const & a) {
     if (is_zero(a))
         return 0;
-    if (is_small(a)) {
-        unsigned r = 0;
-        int v      = a.m_val;
+    if (is_small(a))
+        return static_cast<unsigned>(_trailing_zeros64(static_cast<uint64_t>(a.m_val)));
 #define COUNT_DIGIT_RIGHT_ZEROS()               \
         if (v % (1 << 16) == 0) {               \
             r += 16;                            \
@@ -2192,9 +2240,6 @@ unsigned mpz_manager<SYNCH>::power_of_two_multiple(mpz const & a) {
         if (v % 2 == 0) {                       \
             r++;                                \
         }
-        COUNT_DIGIT_RIGHT_ZEROS();
-        return r;
-    }
 #ifndef _MP_GMP
     mpz_cell * c        = a.m_ptr;
     unsigned sz         = c->m_size;
@@ -2227,7 +2272,7 @@ unsigned mpz_manager<SYNCH>::log2(mpz const & a) {
     if (is_nonpos(a))
         return 0;
     if (is_small(a))
-        return ::log2((unsigned)a.m_val);
+        return uint64_log2(static_cast<uint64_t>(a.m_val));
 #ifndef _MP_GMP
     static_assert(sizeof(digit_t) == 8 || sizeof(digit_t) == 4, "");
     mpz_cell * c     = a.m_ptr;
@@ -2249,7 +2294,7 @@ unsigned mpz_manager<SYNCH>::mlog2(mpz const & a) {
     if (is_nonneg(a))
         return 0;
     if (is_small(a))
-        return ::log2((unsigned)-a.m_val);
+        return uint64_log2(static_cast<uint64_t>(-a.m_val));
 #ifndef _MP_GMP
     static_assert(sizeof(digit_t) == 8 || sizeof(digit_t) == 4, "");
     mpz_cell * c     = a.m_ptr;
@@ -2428,14 +2473,11 @@ template<bool SYNCH>
 bool mpz_manager<SYNCH>::decompose(mpz const & a, svector<digit_t> & digits) {
     digits.reset();
     if (is_small(a)) {
-        if (a.m_val < 0) {
-            digits.push_back(-a.m_val);
-            return true;
-        }
-        else {
-            digits.push_back(a.m_val);
-            return false;
-        }
+        digit_t ds[2];
+        unsigned sz = small_digits(a.m_val, ds);
+        for (unsigned i = 0; i < sz; i++)
+            digits.push_back(ds[i]);
+        return a.m_val < 0;
     }
     else {
 #ifndef _MP_GMP
@@ -2466,9 +2508,9 @@ template<bool SYNCH>
 bool mpz_manager<SYNCH>::get_bit(mpz const & a, unsigned index) {
     if (is_small(a)) {
         SASSERT(a.m_val >= 0);
-        if (index >= 8*sizeof(digit_t))
+        if (index >= 62)
             return false;
-        return 0 != (a.m_val & (1ull << (digit_t)index));
+        return 0 != (a.m_val & (static_cast<int64_t>(1) << index));
     }
     unsigned i = index / (sizeof(digit_t)*8);
     unsigned o = index % (sizeof(digit_t)*8);
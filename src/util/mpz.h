@@ -72,6 +72,8 @@ class mpz_cell {
    \brief Multi-precision integer.
    
    If m_kind == mpz_small, it is a small number and the value is stored in m_val.
+                           Small numbers range over [-(2^61 - 1), 2^61 - 1], so that
+                           m_val, m_kind and m_owner share a single 64-bit word.
    If m_kind == mpz_large,   the value is stored in m_ptr and m_ptr != nullptr.
                            m_val contains the sign (-1 negative, 1 positive)   
                            under winodws, m_ptr points to a mpz_cell that store the value. 
@@ -86,9 +88,9 @@ class mpz {
 #else
     typedef mpz_t mpz_type;
 #endif
-    int        m_val; 
-    unsigned   m_kind:1;
-    unsigned   m_owner:1;
+    int64_t    m_val:62;
+    uint64_t   m_kind:1;
+    uint64_t   m_owner:1;
     mpz_type * m_ptr;
     friend class mpz_manager<true>;
     friend class mpz_manager<false>;
@@ -113,7 +115,7 @@ public:
     }
 
     void swap(mpz & other) { 
-        std::swap(m_val, other.m_val);
+        int64_t v = m_val; m_val = other.m_val; other.m_val = v;
         std::swap(m_ptr, other.m_ptr);
         unsigned o = m_owner; m_owner = other.m_owner; other.m_owner = o;
         unsigned k = m_kind; m_kind = other.m_kind; other.m_kind = k;
@@ -150,7 +152,6 @@ class mpz_manager {
 
 #ifndef _MP_GMP
     unsigned                m_init_cell_capacity;
-    mpz                     m_int_min;
     
     static unsigned cell_size(unsigned capacity) { 
         return sizeof(mpz_cell) + sizeof(digit_t) * capacity; 
@@ -244,13 +245,32 @@ class mpz_manager {
     mpz                     m_two64;
 
 
-    static int64_t i64(mpz const & a) { return static_cast<int64_t>(a.m_val); }
+    static const int64_t small_max = (static_cast<int64_t>(1) << 61) - 1;
+
+    static bool fits_small(int64_t v) { return -small_max <= v && v <= small_max; }
+
+    static int64_t i64(mpz const & a) { return a.m_val; }
+
+    // c <- a * b, return false if the product does not fit in an int64_t.
+    static bool mul_i64(int64_t a, int64_t b, int64_t & c) {
+#if defined(__GNUC__) || defined(__clang__)
+        return !__builtin_mul_overflow(a, b, &c);
+#else
+        SASSERT(fits_small(a) && fits_small(b));
+        uint64_t ua = a < 0 ? -a : a;
+        uint64_t ub = b < 0 ? -b : b;
+        if (ua != 0 && ub > static_cast<uint64_t>(INT64_MAX) / ua)
+            return false;
+        c = a * b;
+        return true;
+#endif
+    }
 
     void set_big_i64(mpz & c, int64_t v);
 
     void set_i64(mpz & c, int64_t v) {
-        if (v >= INT_MIN && v <= INT_MAX) {
-            c.m_val = static_cast<int>(v); 
+        if (fits_small(v)) {
+            c.m_val = v; 
             c.m_kind = mpz_small;
         }
         else {
@@ -306,24 +326,37 @@ class mpz_manager {
         mpz_cell const* cell() { return m_cell; }
     };
 
+    // Return true if the magnitude ds[0..sz) is a small number, and store it in v.
+    static bool is_small_digits(unsigned sz, digit_t const * ds, int64_t & v) {
+        uint64_t u;
+        if (sz == 1)
+            u = ds[0];
+        else if (sz == 2 && sizeof(digit_t) < sizeof(uint64_t))
+            u = static_cast<uint64_t>(ds[0]) | (static_cast<uint64_t>(ds[1]) << 32);
+        else
+            return false;
+        if (u > static_cast<uint64_t>(small_max))
+            return false;
+        v = static_cast<int64_t>(u);
+        return true;
+    }
+
+    // Store the magnitude of the small number v in ds, and return the number of digits used.
+    static unsigned small_digits(int64_t v, digit_t * ds) {
+        uint64_t u = v < 0 ? -v : v;
+        ds[0] = static_cast<digit_t>(u);
+        if (sizeof(digit_t) == sizeof(uint64_t) || (u >> 32) == 0)
+            return 1;
+        ds[1] = static_cast<digit_t>(u >> 32);
+        return 2;
+    }
+
     void get_sign_cell(mpz const & a, int & sign, mpz_cell * & cell, mpz_cell* reserve) {
         if (is_small(a)) {
-            if (a.m_val == INT_MIN) {
-                sign = -1;
-                cell = m_int_min.m_ptr;
-            }
-            else {
-                cell = reserve;
-                cell->m_size = 1;
-                if (a.m_val < 0) {
-                    sign = -1;
-                    cell->m_digits[0] = -a.m_val;
-                }
-                else {
-                    sign = 1;
-                    cell->m_digits[0] = a.m_val;
-                }
-            }
+            SASSERT(reserve->m_capacity >= 2);
+            cell = reserve;
+            sign = a.m_val < 0 ? -1 : 1;
+            cell->m_size = small_digits(a.m_val, cell->m_digits);
         }
         else {
             sign = a.m_val;
@@ -448,10 +481,10 @@ public:
 
     static int sign(mpz const & a) {
 #ifndef _MP_GMP
-        return a.m_val;
+        return (a.m_val > 0) - (a.m_val < 0);
 #else
         if (is_small(a))
-            return a.m_val;
+            return (a.m_val > 0) - (a.m_val < 0);
         else
             return mpz_sgn(*a.m_ptr);
 #endif
@@ -542,10 +575,8 @@ public:
     }
 
     void set(mpz & a, unsigned val) {
-        if (val <= INT_MAX)
-            set(a, static_cast<int>(val));
-        else
-            set(a, static_cast<int64_t>(static_cast<uint64_t>(val)));
+        a.m_val = val;
+        a.m_kind = mpz_small;
     }
 
     void set(mpz & a, char const * val);
@@ -555,8 +586,8 @@ public:
     }
 
     void set(mpz & a, uint64_t val) {
-        if (val < INT_MAX) {
-            a.m_val = static_cast<int>(val);
+        if (val <= static_cast<uint64_t>(small_max)) {
+            a.m_val = static_cast<int64_t>(val);
             a.m_kind = mpz_small;
         }
         else {
@@ -576,7 +607,7 @@ public:
     void reset(mpz & a);
 
     void swap(mpz & a, mpz & b) {
-        std::swap(a.m_val, b.m_val);
+        int64_t v = a.m_val; a.m_val = b.m_val; b.m_val = v;
         std::swap(a.m_ptr, b.m_ptr);
         auto o = a.m_owner; a.m_owner = b.m_owner; b.m_owner = o;
         auto k = a.m_kind; a.m_kind = b.m_kind; b.m_kind = k;